@@ -3,28 +3,392 @@
 #include <iomanip>
 #include <string>
 #include <sstream>
+#include <fstream>
 #include <limits>
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#include <charconv>
+#include <string_view>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
-// CLASE FRACCION 
-class Fraccion {
+// CLASE ENTERO GRANDE
+// Entero de precisión arbitraria en signo-magnitud. Los dígitos se guardan
+// en base 2^32, del menos significativo al más significativo.
+class EnteroGrande {
 private:
-    int numerador;
-    int denominador;
-    
-    int mcd(int a, int b) const {
-        a = abs(a);
-        b = abs(b);
-        while (b != 0) {
-            int temp = b;
-            b = a % b;
-            a = temp;
+    bool negativo;
+    vector<uint32_t> digitos;
+
+    void recortar() {
+        while (!digitos.empty() && digitos.back() == 0)
+            digitos.pop_back();
+        if (digitos.empty())
+            negativo = false;
+    }
+
+    static int compararMagnitud(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+        if (a.size() != b.size())
+            return a.size() < b.size() ? -1 : 1;
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static vector<uint32_t> sumarMagnitud(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+        const vector<uint32_t>& mayor = a.size() >= b.size() ? a : b;
+        const vector<uint32_t>& menor = a.size() >= b.size() ? b : a;
+        vector<uint32_t> r(mayor.size() + 1);
+        uint64_t acarreo = 0;
+        for (size_t i = 0; i < mayor.size(); i++) {
+            uint64_t s = (uint64_t)mayor[i] + (i < menor.size() ? menor[i] : 0) + acarreo;
+            r[i] = (uint32_t)s;
+            acarreo = s >> 32;
+        }
+        r[mayor.size()] = (uint32_t)acarreo;
+        return r;
+    }
+
+    // Requiere |a| >= |b|
+    static vector<uint32_t> restarMagnitud(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+        vector<uint32_t> r(a.size());
+        int64_t prestamo = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            int64_t d = (int64_t)a[i] - (i < b.size() ? b[i] : 0) - prestamo;
+            prestamo = d < 0 ? 1 : 0;
+            r[i] = (uint32_t)(d + (prestamo << 32));
+        }
+        return r;
+    }
+
+    static vector<uint32_t> multiplicarMagnitud(const vector<uint32_t>& a, const vector<uint32_t>& b) {
+        if (a.empty() || b.empty())
+            return vector<uint32_t>();
+        vector<uint32_t> r(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); i++) {
+            uint64_t acarreo = 0;
+            for (size_t j = 0; j < b.size(); j++) {
+                uint64_t t = (uint64_t)a[i] * b[j] + r[i + j] + acarreo;
+                r[i + j] = (uint32_t)t;
+                acarreo = t >> 32;
+            }
+            r[i + b.size()] = (uint32_t)acarreo;
+        }
+        return r;
+    }
+
+    // División larga (algoritmo D de Knuth). Requiere v distinto de cero.
+    static void dividirMagnitud(const vector<uint32_t>& u, const vector<uint32_t>& v,
+                                vector<uint32_t>& cociente, vector<uint32_t>& resto) {
+        if (compararMagnitud(u, v) < 0) {
+            cociente.clear();
+            resto = u;
+            return;
+        }
+
+        const size_t n = v.size();
+        const size_t m = u.size();
+
+        if (n == 1) {
+            uint64_t r = 0;
+            cociente.assign(m, 0);
+            for (size_t i = m; i-- > 0;) {
+                uint64_t actual = (r << 32) | u[i];
+                cociente[i] = (uint32_t)(actual / v[0]);
+                r = actual % v[0];
+            }
+            resto.clear();
+            if (r != 0)
+                resto.push_back((uint32_t)r);
+            return;
+        }
+
+        // Normaliza para que el dígito más alto del divisor tenga el bit superior en 1
+        const int s = __builtin_clz(v[n - 1]);
+        vector<uint32_t> vn(n), un(m + 1);
+        for (size_t i = n - 1; i > 0; i--)
+            vn[i] = (uint32_t)(((uint64_t)v[i] << s) | ((uint64_t)v[i - 1] >> (32 - s)));
+        vn[0] = v[0] << s;
+        un[m] = (uint32_t)((uint64_t)u[m - 1] >> (32 - s));
+        for (size_t i = m - 1; i > 0; i--)
+            un[i] = (uint32_t)(((uint64_t)u[i] << s) | ((uint64_t)u[i - 1] >> (32 - s)));
+        un[0] = u[0] << s;
+
+        const uint64_t base = (uint64_t)1 << 32;
+        cociente.assign(m - n + 1, 0);
+        for (size_t j = m - n + 1; j-- > 0;) {
+            uint64_t numerador = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+            uint64_t qhat = numerador / vn[n - 1];
+            uint64_t rhat = numerador % vn[n - 1];
+            while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+                qhat--;
+                rhat += vn[n - 1];
+                if (rhat >= base)
+                    break;
+            }
+
+            int64_t k = 0, t;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t p = qhat * vn[i];
+                t = (int64_t)un[i + j] - k - (int64_t)(p & 0xFFFFFFFFu);
+                un[i + j] = (uint32_t)t;
+                k = (int64_t)(p >> 32) - (t >> 32);
+            }
+            t = (int64_t)un[j + n] - k;
+            un[j + n] = (uint32_t)t;
+
+            cociente[j] = (uint32_t)qhat;
+            if (t < 0) {
+                // qhat resultó una unidad mayor: se suma de vuelta el divisor
+                cociente[j]--;
+                uint64_t acarreo = 0;
+                for (size_t i = 0; i < n; i++) {
+                    uint64_t suma = (uint64_t)un[i + j] + vn[i] + acarreo;
+                    un[i + j] = (uint32_t)suma;
+                    acarreo = suma >> 32;
+                }
+                un[j + n] += (uint32_t)acarreo;
+            }
+        }
+
+        resto.assign(n, 0);
+        for (size_t i = 0; i < n - 1; i++)
+            resto[i] = (uint32_t)(((uint64_t)un[i] >> s) | ((uint64_t)un[i + 1] << (32 - s)));
+        resto[n - 1] = un[n - 1] >> s;
+    }
+
+    static EnteroGrande desdeMagnitud(vector<uint32_t> magnitud, bool negativo) {
+        EnteroGrande r;
+        r.digitos.swap(magnitud);
+        r.negativo = negativo;
+        r.recortar();
+        return r;
+    }
+
+public:
+    EnteroGrande() : negativo(false) {}
+    EnteroGrande(long long valor) : negativo(valor < 0) {
+        // Se calcula la magnitud sin pasar por -valor para admitir LLONG_MIN
+        uint64_t magnitud = valor < 0 ? (uint64_t)(-(valor + 1)) + 1 : (uint64_t)valor;
+        while (magnitud != 0) {
+            digitos.push_back((uint32_t)magnitud);
+            magnitud >>= 32;
+        }
+    }
+
+    bool esCero() const { return digitos.empty(); }
+    bool esUno() const { return !negativo && digitos.size() == 1 && digitos[0] == 1; }
+    bool esNegativo() const { return negativo; }
+
+    // Devuelve true y el valor si cabe en [-LLONG_MAX, LLONG_MAX]
+    bool aLongLong(long long& salida) const {
+        if (digitos.size() > 2)
+            return false;
+        uint64_t magnitud = 0;
+        for (size_t i = digitos.size(); i-- > 0;)
+            magnitud = (magnitud << 32) | digitos[i];
+        if (magnitud > (uint64_t)LLONG_MAX)
+            return false;
+        salida = negativo ? -(long long)magnitud : (long long)magnitud;
+        return true;
+    }
+
+    EnteroGrande valorAbsoluto() const {
+        EnteroGrande r = *this;
+        r.negativo = false;
+        return r;
+    }
+
+    EnteroGrande operator-() const {
+        EnteroGrande r = *this;
+        if (!r.esCero())
+            r.negativo = !r.negativo;
+        return r;
+    }
+
+    EnteroGrande operator+(const EnteroGrande& o) const {
+        if (negativo == o.negativo)
+            return desdeMagnitud(sumarMagnitud(digitos, o.digitos), negativo);
+        if (compararMagnitud(digitos, o.digitos) >= 0)
+            return desdeMagnitud(restarMagnitud(digitos, o.digitos), negativo);
+        return desdeMagnitud(restarMagnitud(o.digitos, digitos), o.negativo);
+    }
+
+    EnteroGrande operator-(const EnteroGrande& o) const {
+        return *this + (-o);
+    }
+
+    EnteroGrande operator*(const EnteroGrande& o) const {
+        return desdeMagnitud(multiplicarMagnitud(digitos, o.digitos), negativo != o.negativo);
+    }
+
+    // División truncada hacia cero. Requiere divisor distinto de cero.
+    EnteroGrande operator/(const EnteroGrande& o) const {
+        vector<uint32_t> q, r;
+        dividirMagnitud(digitos, o.digitos, q, r);
+        return desdeMagnitud(q, negativo != o.negativo);
+    }
+
+    EnteroGrande operator%(const EnteroGrande& o) const {
+        vector<uint32_t> q, r;
+        dividirMagnitud(digitos, o.digitos, q, r);
+        return desdeMagnitud(r, negativo);
+    }
+
+    bool operator==(const EnteroGrande& o) const {
+        return negativo == o.negativo && digitos == o.digitos;
+    }
+
+    bool operator!=(const EnteroGrande& o) const { return !(*this == o); }
+
+    static EnteroGrande mcd(EnteroGrande a, EnteroGrande b) {
+        a.negativo = false;
+        b.negativo = false;
+        while (!b.esCero()) {
+            EnteroGrande temp = a % b;
+            a = b;
+            b = temp;
         }
         return a;
     }
+
+    // Descompone |valor| = mantisa * 2^exponente con mantisa en [0.5, 1)
+    double mantisa(int& exponente) const {
+        if (digitos.empty()) {
+            exponente = 0;
+            return 0.0;
+        }
+        // Con los tres dígitos superiores basta para la precisión de un double
+        double acumulado = 0.0;
+        size_t inicio = digitos.size() > 3 ? digitos.size() - 3 : 0;
+        for (size_t i = digitos.size(); i-- > inicio;)
+            acumulado = acumulado * 4294967296.0 + digitos[i];
+        int e;
+        double m = frexp(acumulado, &e);
+        exponente = e + 32 * (int)inicio;
+        return m;
+    }
+
+    double aDecimal() const {
+        int e;
+        double m = mantisa(e);
+        return (negativo ? -1.0 : 1.0) * ldexp(m, e);
+    }
+
+    string aString() const {
+        if (digitos.empty())
+            return "0";
+        // Extrae bloques de nueve cifras decimales dividiendo por 10^9
+        vector<uint32_t> resto = digitos;
+        vector<uint32_t> bloques;
+        while (!resto.empty()) {
+            uint64_t r = 0;
+            for (size_t i = resto.size(); i-- > 0;) {
+                uint64_t actual = (r << 32) | resto[i];
+                resto[i] = (uint32_t)(actual / 1000000000u);
+                r = actual % 1000000000u;
+            }
+            while (!resto.empty() && resto.back() == 0)
+                resto.pop_back();
+            bloques.push_back((uint32_t)r);
+        }
+        string s = negativo ? "-" : "";
+        s += to_string(bloques.back());
+        for (size_t i = bloques.size() - 1; i-- > 0;) {
+            string b = to_string(bloques[i]);
+            s += string(9 - b.size(), '0') + b;
+        }
+        return s;
+    }
+};
+
+// Entero ancho usado por los acumuladores que posponen la simplificación
+#ifdef __SIZEOF_INT128__
+typedef __int128 EnteroAncho;
+typedef unsigned __int128 EnteroAnchoSinSigno;
+#else
+typedef long long EnteroAncho;
+typedef unsigned long long EnteroAnchoSinSigno;
+#endif
+
+inline constexpr int contarCerosFinales(unsigned long long v) {
+    return __builtin_ctzll(v);
+}
+
+#ifdef __SIZEOF_INT128__
+inline constexpr int contarCerosFinales(unsigned __int128 v) {
+    unsigned long long bajo = (unsigned long long)v;
+    return bajo != 0 ? __builtin_ctzll(bajo) : 64 + __builtin_ctzll((unsigned long long)(v >> 64));
+}
+#endif
+
+// MCD binario (Stein): solo desplazamientos y restas, saltando con ctz
+// todos los factores 2 de una vez en lugar de dividir
+template <typename SinSigno>
+constexpr SinSigno mcdBinario(SinSigno a, SinSigno b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int ceros = contarCerosFinales(a);
+    int k = contarCerosFinales(a | b);
+    b >>= contarCerosFinales(b);
+    // La diferencia y el mínimo se calculan en paralelo para no encadenar
+    // el ctz con el intercambio en cada vuelta
+    while (a != 0) {
+        a >>= ceros;
+        SinSigno diferencia = a > b ? a - b : b - a;
+        // El bit alto evita el ctz de cero en la última vuelta
+        ceros = contarCerosFinales(diferencia | ((SinSigno)1 << (sizeof(SinSigno) * 8 - 1)));
+        b = a < b ? a : b;
+        a = diferencia;
+    }
+    return b << k;
+}
+
+// Representación de una fracción cuyo numerador o denominador no cabe en 64 bits
+struct FraccionGrande {
+    EnteroGrande numerador;
+    EnteroGrande denominador;
+};
+
+// CLASE FRACCION 
+// En el caso común guarda numerador y denominador en dos palabras de 64 bits
+// sin reservar memoria. Si una operación se desborda, el resultado pasa a una
+// FraccionGrande en el heap; cuando vuelve a caber, regresa a la forma compacta.
+// Un denominador igual a 0 marca la representación grande.
+class Fraccion {
+private:
+    union {
+        long long numerador;
+        FraccionGrande* grande;
+    };
+    long long denominador;
+
+    // Nunca recibe LLONG_MIN, así que el valor absoluto siempre existe
+    static constexpr long long mcd(long long a, long long b) {
+        return (long long)mcdBinario<unsigned long long>(a < 0 ? -a : a, b < 0 ? -b : b);
+    }
     
-    void simplificar() {
+    constexpr void simplificar() {
         if (denominador == 0) {
             cerr << "Error: Denominador no puede ser cero!" << endl;
             denominador = 1;
@@ -34,192 +398,2356 @@ private:
             numerador = -numerador;
             denominador = -denominador;
         }
-        
-        int divisor = mcd(abs(numerador), abs(denominador));
-        if (divisor > 1) {
-            numerador /= divisor;
-            denominador /= divisor;
+        
+        long long divisor = mcd(numerador, denominador);
+        if (divisor > 1) {
+            numerador /= divisor;
+            denominador /= divisor;
+        }
+    }
+
+    // Construye la fracción reducida n/d a partir de enteros grandes,
+    // volviendo a la forma compacta si ambos caben en 64 bits
+    void asignarGrande(EnteroGrande n, EnteroGrande d) {
+        if (d.esCero()) {
+            cerr << "Error: Denominador no puede ser cero!" << endl;
+            d = EnteroGrande(1);
+        }
+        if (d.esNegativo()) {
+            n = -n;
+            d = -d;
+        }
+        EnteroGrande divisor = EnteroGrande::mcd(n, d);
+        if (divisor != EnteroGrande(1) && !divisor.esCero()) {
+            n = n / divisor;
+            d = d / divisor;
+        }
+
+        long long nc, dc;
+        if (n.aLongLong(nc) && d.aLongLong(dc)) {
+            numerador = nc;
+            denominador = dc;
+        } else {
+            grande = new FraccionGrande{n, d};
+            denominador = 0;
+        }
+    }
+
+    constexpr void liberar() {
+        if (denominador == 0)
+            delete grande;
+    }
+
+    constexpr void copiarDe(const Fraccion& f) {
+        denominador = f.denominador;
+        if (f.denominador == 0)
+            grande = new FraccionGrande(*f.grande);
+        else
+            numerador = f.numerador;
+    }
+
+    EnteroGrande numeradorGrande() const {
+        return esGrande() ? grande->numerador : EnteroGrande(numerador);
+    }
+
+    EnteroGrande denominadorGrande() const {
+        return esGrande() ? grande->denominador : EnteroGrande(denominador);
+    }
+
+public:
+    // Construye n/d reducida a partir de enteros de precisión arbitraria
+    static Fraccion desdeGrandes(const EnteroGrande& n, const EnteroGrande& d) {
+        Fraccion r;
+        r.asignarGrande(n, d);
+        return r;
+    }
+
+    constexpr Fraccion() : numerador(0), denominador(1) {}
+    constexpr Fraccion(long long n) : numerador(n), denominador(1) {
+        if (n == LLONG_MIN)
+            asignarGrande(EnteroGrande(n), EnteroGrande(1));
+    }
+    constexpr Fraccion(long long n, long long d) : numerador(n), denominador(d) {
+        // LLONG_MIN no tiene opuesto en 64 bits, se delega a la forma grande
+        if (n == LLONG_MIN || d == LLONG_MIN)
+            asignarGrande(EnteroGrande(n), EnteroGrande(d));
+        else
+            simplificar();
+    }
+
+    constexpr Fraccion(const Fraccion& f) { copiarDe(f); }
+    constexpr Fraccion(Fraccion&& f) noexcept : numerador(f.numerador), denominador(f.denominador) {
+        f.numerador = 0;
+        f.denominador = 1;
+    }
+
+    constexpr Fraccion& operator=(const Fraccion& f) {
+        if (this != &f) {
+            liberar();
+            copiarDe(f);
+        }
+        return *this;
+    }
+
+    constexpr Fraccion& operator=(Fraccion&& f) noexcept {
+        if (this != &f) {
+            liberar();
+            numerador = f.numerador;
+            denominador = f.denominador;
+            f.numerador = 0;
+            f.denominador = 1;
+        }
+        return *this;
+    }
+
+    constexpr ~Fraccion() { liberar(); }
+
+    // Indica si la fracción usa la representación de precisión arbitraria
+    constexpr bool esGrande() const { return denominador == 0; }
+
+    // Solo válidos en la forma compacta; para la forma grande usar aString()
+    constexpr long long getNumerador() const { return esGrande() ? 0 : numerador; }
+    constexpr long long getDenominador() const { return esGrande() ? 1 : denominador; }
+    
+    constexpr double aDecimal() const {
+        if (!esGrande())
+            return static_cast<double>(numerador) / denominador;
+        int en, ed;
+        double mn = grande->numerador.mantisa(en);
+        double md = grande->denominador.mantisa(ed);
+        return (grande->numerador.esNegativo() ? -1.0 : 1.0) * ldexp(mn / md, en - ed);
+    }
+    
+    constexpr Fraccion operator+(const Fraccion& f) const {
+        long long a, b, n, d;
+        if (!esGrande() && !f.esGrande() &&
+            !__builtin_mul_overflow(numerador, f.denominador, &a) &&
+            !__builtin_mul_overflow(f.numerador, denominador, &b) &&
+            !__builtin_add_overflow(a, b, &n) &&
+            !__builtin_mul_overflow(denominador, f.denominador, &d))
+            return Fraccion(n, d);
+        return desdeGrandes(numeradorGrande() * f.denominadorGrande() +
+                            f.numeradorGrande() * denominadorGrande(),
+                            denominadorGrande() * f.denominadorGrande());
+    }
+    
+    constexpr Fraccion operator-(const Fraccion& f) const {
+        long long a, b, n, d;
+        if (!esGrande() && !f.esGrande() &&
+            !__builtin_mul_overflow(numerador, f.denominador, &a) &&
+            !__builtin_mul_overflow(f.numerador, denominador, &b) &&
+            !__builtin_sub_overflow(a, b, &n) &&
+            !__builtin_mul_overflow(denominador, f.denominador, &d))
+            return Fraccion(n, d);
+        return desdeGrandes(numeradorGrande() * f.denominadorGrande() -
+                            f.numeradorGrande() * denominadorGrande(),
+                            denominadorGrande() * f.denominadorGrande());
+    }
+    
+    constexpr Fraccion operator*(const Fraccion& f) const {
+        long long n, d;
+        if (!esGrande() && !f.esGrande() &&
+            !__builtin_mul_overflow(numerador, f.numerador, &n) &&
+            !__builtin_mul_overflow(denominador, f.denominador, &d))
+            return Fraccion(n, d);
+        return desdeGrandes(numeradorGrande() * f.numeradorGrande(),
+                            denominadorGrande() * f.denominadorGrande());
+    }
+    
+    constexpr Fraccion operator/(const Fraccion& f) const {
+        long long n, d;
+        if (!esGrande() && !f.esGrande() &&
+            !__builtin_mul_overflow(numerador, f.denominador, &n) &&
+            !__builtin_mul_overflow(denominador, f.numerador, &d))
+            return Fraccion(n, d);
+        return desdeGrandes(numeradorGrande() * f.denominadorGrande(),
+                            denominadorGrande() * f.numeradorGrande());
+    }
+    
+    constexpr Fraccion operator-() const {
+        if (!esGrande())
+            return Fraccion(-numerador, denominador);
+        return desdeGrandes(-grande->numerador, grande->denominador);
+    }
+    
+    // Ambas fracciones están siempre reducidas y en su forma canónica,
+    // así que basta comparar componente a componente
+    constexpr bool operator==(const Fraccion& f) const {
+        if (esGrande() != f.esGrande())
+            return false;
+        if (!esGrande())
+            return numerador == f.numerador && denominador == f.denominador;
+        return grande->numerador == f.grande->numerador &&
+               grande->denominador == f.grande->denominador;
+    }
+    
+    // Aproxima un decimal por la última convergente de su fracción continua
+    // cuyo denominador no supera maxDenominador
+    static Fraccion desdeDecimal(double valor, long long maxDenominador = 1000000) {
+        if (!std::isfinite(valor) || fabs(valor) >= 9.2e18) {
+            cerr << "Error: Valor fuera del rango de una fraccion!" << endl;
+            return Fraccion();
+        }
+        bool negativo = valor < 0;
+        double resto = fabs(valor);
+        long long p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+        for (int i = 0; i < 64; i++) {
+            double parteEntera = floor(resto);
+            long long a = (long long)parteEntera;
+            long long p2, q2;
+            if (__builtin_mul_overflow(a, p1, &p2) || __builtin_add_overflow(p2, p0, &p2) ||
+                __builtin_mul_overflow(a, q1, &q2) || __builtin_add_overflow(q2, q0, &q2) ||
+                q2 > maxDenominador)
+                break;
+            p0 = p1; q0 = q1;
+            p1 = p2; q1 = q2;
+            double fraccional = resto - parteEntera;
+            if (fraccional < 1e-18)
+                break;
+            resto = 1.0 / fraccional;
+        }
+        return Fraccion(negativo ? -p1 : p1, q1);
+    }
+    
+    double raizCuadrada() const {
+        return sqrt(aDecimal());
+    }
+    
+    // Longitud máxima del texto de una fracción compacta ("-<19 cifras>/<19 cifras>")
+    static const size_t MAX_CARACTERES = 40;
+
+    // Texto de la forma grande; los enteros sin "/1", como en la compacta
+    string textoGrande() const {
+        if (grande->denominador.esUno())
+            return grande->numerador.aString();
+        return grande->numerador.aString() + "/" + grande->denominador.aString();
+    }
+
+    // Escribe la fracción en [destino, fin) con to_chars, sin reservar memoria
+    // en la forma compacta. Devuelve el final de lo escrito o nullptr si no cabe.
+    char* escribir(char* destino, char* fin) const {
+        if (esGrande()) {
+            string texto = textoGrande();
+            if ((size_t)(fin - destino) < texto.size())
+                return nullptr;
+            return copy(texto.begin(), texto.end(), destino);
+        }
+        to_chars_result r = to_chars(destino, fin, numerador);
+        if (r.ec != errc())
+            return nullptr;
+        if (denominador == 1)
+            return r.ptr;
+        if (r.ptr == fin)
+            return nullptr;
+        *r.ptr = '/';
+        r = to_chars(r.ptr + 1, fin, denominador);
+        return r.ec == errc() ? r.ptr : nullptr;
+    }
+    
+    void imprimir() const {
+        cout << *this;
+    }
+    
+    string aString() const {
+        if (esGrande()) {
+            return textoGrande();
+        }
+        char texto[MAX_CARACTERES];
+        return string(texto, escribir(texto, texto + MAX_CARACTERES));
+    }
+    
+    // Se escribe como un solo bloque, así setw se aplica a la fracción completa
+    friend ostream& operator<<(ostream& os, const Fraccion& f) {
+        if (f.esGrande())
+            return os << f.aString();
+        char texto[MAX_CARACTERES];
+        return os << string_view(texto, f.escribir(texto, texto + MAX_CARACTERES) - texto);
+    }
+};
+
+// CLASE ACUMULADOR DE FRACCIONES
+// Acumula sumas de fracciones y de productos sin simplificar, en enteros del
+// doble de ancho. Solo se reduce (con el MCD binario) cuando la siguiente
+// operación se desbordaría o cuando se pide el resultado como Fraccion para
+// compararlo o imprimirlo. Si aun reducido no cabe, continúa sobre una
+// Fraccion de precisión arbitraria.
+class AcumuladorFraccion {
+private:
+    EnteroAncho numerador;
+    EnteroAncho denominador;
+    Fraccion respaldo;      // Valor exacto cuando el entero ancho no basta
+    bool usaRespaldo;
+
+    static EnteroGrande aEnteroGrande(EnteroAncho v) {
+        bool negativo = v < 0;
+        EnteroAnchoSinSigno magnitud = negativo ? -(EnteroAnchoSinSigno)v : (EnteroAnchoSinSigno)v;
+        EnteroGrande r(0);
+        const EnteroGrande base(1LL << 32);
+        for (int desplazamiento = (int)sizeof(EnteroAncho) * 8 - 32; desplazamiento >= 0; desplazamiento -= 32)
+            r = r * base + EnteroGrande((long long)(uint32_t)(magnitud >> desplazamiento));
+        return negativo ? -r : r;
+    }
+
+    constexpr void reducir() {
+        EnteroAnchoSinSigno magnitud = numerador < 0 ? -(EnteroAnchoSinSigno)numerador
+                                                     : (EnteroAnchoSinSigno)numerador;
+        EnteroAnchoSinSigno divisor = mcdBinario(magnitud, (EnteroAnchoSinSigno)denominador);
+        if (divisor > 1) {
+            numerador /= (EnteroAncho)divisor;
+            denominador /= (EnteroAncho)divisor;
+        }
+    }
+
+    // Intenta numerador/denominador + n/d en el entero ancho
+    constexpr bool intentarSumar(EnteroAncho n, EnteroAncho d) {
+        EnteroAncho a, b, suma, producto;
+        if (d == denominador) {
+            if (__builtin_add_overflow(numerador, n, &suma))
+                return false;
+            numerador = suma;
+            return true;
+        }
+
+
+        if (__builtin_mul_overflow(numerador, d, &a) ||
+            __builtin_mul_overflow(n, denominador, &b) ||
+            __builtin_add_overflow(a, b, &suma) ||
+            __builtin_mul_overflow(denominador, d, &producto))
+            return false;
+        numerador = suma;
+        denominador = producto;
+        return true;
+    }
+
+    void pasarARespaldo() {
+        respaldo = Fraccion::desdeGrandes(aEnteroGrande(numerador), aEnteroGrande(denominador));
+        usaRespaldo = true;
+    }
+
+    // Devuelve false si hubo que pasar al respaldo; en ese caso n/d no se sumó
+    constexpr bool sumarAncho(EnteroAncho n, EnteroAncho d) {
+        if (intentarSumar(n, d))
+            return true;
+        reducir();
+        if (intentarSumar(n, d))
+            return true;
+        pasarARespaldo();
+        return false;
+    }
+
+public:
+    constexpr AcumuladorFraccion() : numerador(0), denominador(1), usaRespaldo(false) {}
+
+    constexpr void sumar(const Fraccion& f) {
+        if (!usaRespaldo && !f.esGrande() && sumarAncho(f.getNumerador(), f.getDenominador()))
+            return;
+        if (!usaRespaldo)
+            pasarARespaldo();
+        respaldo = respaldo + f;
+    }
+
+    // Suma a*b sin simplificar el producto intermedio
+    constexpr void sumarProducto(const Fraccion& a, const Fraccion& b) {
+        EnteroAncho n, d;
+        if (!usaRespaldo && !a.esGrande() && !b.esGrande() &&
+            !__builtin_mul_overflow((EnteroAncho)a.getNumerador(), (EnteroAncho)b.getNumerador(), &n) &&
+            !__builtin_mul_overflow((EnteroAncho)a.getDenominador(), (EnteroAncho)b.getDenominador(), &d) &&
+            sumarAncho(n, d))
+            return;
+        sumar(a * b);
+    }
+
+    // Devuelve el valor acumulado ya simplificado
+    constexpr Fraccion resultado() const {
+        if (usaRespaldo)
+            return respaldo;
+        AcumuladorFraccion copia = *this;
+        copia.reducir();
+        if (copia.numerador >= -LLONG_MAX && copia.numerador <= LLONG_MAX &&
+            copia.denominador <= LLONG_MAX)
+            return Fraccion((long long)copia.numerador, (long long)copia.denominador);
+        return Fraccion::desdeGrandes(aEnteroGrande(copia.numerador), aEnteroGrande(copia.denominador));
+    }
+};
+
+// Acumulador directo para escalares que no necesitan simplificar
+template <typename T>
+class AcumuladorSimple {
+private:
+    T suma;
+
+public:
+    constexpr AcumuladorSimple() : suma(0) {}
+    constexpr void sumar(const T& v) { suma = suma + v; }
+    constexpr void sumarProducto(const T& a, const T& b) { suma = suma + a * b; }
+    constexpr T resultado() const { return suma; }
+};
+
+// RASGOS DEL ESCALAR
+// Resuelven en compilación cómo pasa cada tipo de componente a decimal,
+// cómo se construye desde n/d y con qué acumulador se suma. Cubre double,
+// float y los tipos enteros; Fraccion tiene su especialización.
+template <typename T>
+struct RasgosEscalar {
+    // float se mantiene en float para no ensanchar los bucles vectorizados
+    typedef typename conditional<is_same<T, float>::value, float, double>::type Real;
+    typedef AcumuladorSimple<T> Acumulador;
+
+    static constexpr Real aReal(const T& v) { return static_cast<Real>(v); }
+
+    static T desdeFraccion(int n, int d) {
+        static_assert(!is_integral<T>::value, "Un escalar entero no puede representar n/d");
+        return static_cast<T>(n) / static_cast<T>(d);
+    }
+
+    static T desdeDecimal(double v, long long) {
+        return is_integral<T>::value ? static_cast<T>(llround(v)) : static_cast<T>(v);
+    }
+};
+
+template <>
+struct RasgosEscalar<Fraccion> {
+    typedef double Real;
+    typedef AcumuladorFraccion Acumulador;
+
+    static constexpr Real aReal(const Fraccion& f) { return f.aDecimal(); }
+    static constexpr Fraccion desdeFraccion(int n, int d) { return Fraccion(n, d); }
+    static Fraccion desdeDecimal(double v, long long maxDenominador) {
+        return Fraccion::desdeDecimal(v, maxDenominador);
+    }
+};
+
+//  CLASE VECTOR3D 
+// Plantilla sobre el tipo de las componentes. Vector3D (con Fraccion) es la
+// versión exacta; Vector3DDoble y Vector3DFlotante sirven para los bucles
+// donde basta punto flotante, sin ningún costo de despacho en ejecución.
+template <typename T>
+class Vector3DT {
+private:
+    T x, y, z;
+
+    typedef RasgosEscalar<T> Rasgos;
+
+public:
+    typedef T Escalar;
+    typedef typename Rasgos::Real Real;
+
+    constexpr Vector3DT() : x(0), y(0), z(0) {}
+    constexpr Vector3DT(T x, T y, T z) : x(x), y(y), z(z) {}
+    constexpr Vector3DT(int xn, int xd, int yn, int yd, int zn, int zd) 
+        : x(Rasgos::desdeFraccion(xn, xd)), y(Rasgos::desdeFraccion(yn, yd)),
+          z(Rasgos::desdeFraccion(zn, zd)) {}
+    
+    constexpr const T& getX() const { return x; }
+    constexpr const T& getY() const { return y; }
+    constexpr const T& getZ() const { return z; }
+    
+    Real magnitud() const {
+        Real mx = Rasgos::aReal(x);
+        Real my = Rasgos::aReal(y);
+        Real mz = Rasgos::aReal(z);
+        return sqrt(mx*mx + my*my + mz*mz);
+    }
+    
+    void normalizarYMostrar() const {
+        Real mag = magnitud();
+        if (mag == 0) {
+            cout << "No se puede normalizar el vector cero" << endl;
+            return;
+        }
+        cout << "Vector normalizado (decimal): (" 
+             << Rasgos::aReal(x)/mag << ", " 
+             << Rasgos::aReal(y)/mag << ", " 
+             << Rasgos::aReal(z)/mag << ")" << endl;
+    }
+    
+    constexpr Vector3DT operator+(const Vector3DT& v) const {
+        return Vector3DT(x + v.x, y + v.y, z + v.z);
+    }
+    
+    constexpr Vector3DT operator-(const Vector3DT& v) const {
+        return Vector3DT(x - v.x, y - v.y, z - v.z);
+    }
+    
+    // Con Fraccion los tres productos se acumulan sin simplificar y se
+    // reduce una sola vez
+    constexpr T operator*(const Vector3DT& v) const {
+        typename Rasgos::Acumulador suma;
+        suma.sumarProducto(x, v.x);
+        suma.sumarProducto(y, v.y);
+        suma.sumarProducto(z, v.z);
+        return suma.resultado();
+    }
+    
+    constexpr Vector3DT operator*(const T& f) const {
+        return Vector3DT(x * f, y * f, z * f);
+    }
+    
+    // Escalar entero de otro tipo; si T ya es ese entero se usa la anterior
+    template <typename Entero,
+              typename = typename enable_if<is_integral<Entero>::value && !is_same<Entero, T>::value>::type>
+    constexpr Vector3DT operator*(Entero n) const {
+        return *this * T(n);
+    }
+    
+    // Suma todos los vectores con un acumulador por componente
+    static Vector3DT sumarTodos(const vector<Vector3DT>& vectores) {
+        typename Rasgos::Acumulador sx, sy, sz;
+        for (const Vector3DT& v : vectores) {
+            sx.sumar(v.x);
+            sy.sumar(v.y);
+            sz.sumar(v.z);
+        }
+        return Vector3DT(sx.resultado(), sy.resultado(), sz.resultado());
+    }
+    
+    void imprimir(const string& etiqueta = "Vector") const {
+        cout << etiqueta << ": (" << x << ", " << y << ", " << z << ")\n";
+    }
+    
+    friend ostream& operator<<(ostream& os, const Vector3DT& v) {
+        os << "(" << v.x << ", " << v.y << ", " << v.z << ")";
+        return os;
+    }
+    
+    friend constexpr Vector3DT operator*(const T& f, const Vector3DT& v) {
+        return v * f;
+    }
+    
+    template <typename Entero,
+              typename = typename enable_if<is_integral<Entero>::value && !is_same<Entero, T>::value>::type>
+    friend constexpr Vector3DT operator*(Entero n, const Vector3DT& v) {
+        return v * n;
+    }
+};
+
+typedef Vector3DT<Fraccion> Vector3D;
+typedef Vector3DT<double> Vector3DDoble;
+typedef Vector3DT<float> Vector3DFlotante;
+
+//  CONSTANTES EN TIEMPO DE COMPILACION
+// Fraccion y Vector3DT se pueden evaluar en contextos constexpr mientras los
+// valores quepan en la forma compacta, así que relaciones fijas y vectores
+// unitarios se calculan al compilar. Los static_assert comprueban que el
+// plegado ocurre y que el resultado es el exacto.
+
+constexpr Fraccion RELACION_PINON_CORONA = Fraccion(18, 48);
+constexpr Fraccion RELACION_REDUCTORA = Fraccion(1, 5) * Fraccion(12, 30);
+constexpr Fraccion RELACION_TOTAL = RELACION_PINON_CORONA * RELACION_REDUCTORA;
+
+constexpr Vector3D EJE_X(1, 0, 0);
+constexpr Vector3D EJE_Y(0, 1, 0);
+constexpr Vector3D EJE_Z(0, 0, 1);
+constexpr Vector3D DIAGONAL = EJE_X + EJE_Y + EJE_Z;
+
+static_assert(RELACION_PINON_CORONA == Fraccion(3, 8), "18/48 debe simplificarse a 3/8");
+static_assert(RELACION_TOTAL == Fraccion(3, 100), "3/8 * 1/5 * 2/5 = 3/100");
+static_assert(RELACION_TOTAL.getNumerador() == 3 && RELACION_TOTAL.getDenominador() == 100,
+              "La relación total queda reducida");
+static_assert(Fraccion(1, 2) + Fraccion(1, 3) - Fraccion(5, 6) == Fraccion(0), "1/2 + 1/3 - 5/6 = 0");
+static_assert(Fraccion(-4, -6) == Fraccion(2, 3) && -Fraccion(2, 3) == Fraccion(2, -3),
+              "El signo se normaliza en el denominador");
+static_assert(Fraccion(3, 4) / Fraccion(9, 8) == Fraccion(2, 3), "3/4 : 9/8 = 2/3");
+static_assert(EJE_X * EJE_Y == Fraccion(0) && EJE_Y * EJE_Z == Fraccion(0), "Ejes perpendiculares");
+static_assert(DIAGONAL * DIAGONAL == Fraccion(3), "|(1, 1, 1)|^2 = 3");
+static_assert((DIAGONAL * RELACION_TOTAL).getZ() == Fraccion(3, 100), "Escalado exacto");
+static_assert((Vector3D(1, 2, 1, 3, 1, 6) - EJE_X * Fraccion(1, 2)) * DIAGONAL == Fraccion(1, 2),
+              "(0, 1/3, 1/6) · (1, 1, 1) = 1/2");
+static_assert(Vector3DDoble(1.0, 2.0, 2.0) * Vector3DDoble(2.0, 0.5, 1.0) == 5.0,
+              "También se pliegan los vectores de punto flotante");
+
+//  FORMATO SIN RESERVAS
+// Funciones que escriben valores en un búfer del llamador con to_chars.
+// Todas devuelven el final de lo escrito, o nullptr si no cabe.
+
+inline char* escribirValor(char* destino, char* fin, const Fraccion& f) {
+    return f.escribir(destino, fin);
+}
+
+// Decimales: con precision 0 se usa la representación más corta que se lee
+// de vuelta igual; si no, el mismo formato que cout << setprecision(precision)
+inline char* escribirValor(char* destino, char* fin, double v, int precision = 0) {
+    to_chars_result r = precision > 0 ? to_chars(destino, fin, v, chars_format::general, precision)
+                                      : to_chars(destino, fin, v);
+    return r.ec == errc() ? r.ptr : nullptr;
+}
+
+inline char* escribirValor(char* destino, char* fin, float v, int precision = 0) {
+    to_chars_result r = precision > 0 ? to_chars(destino, fin, v, chars_format::general, precision)
+                                      : to_chars(destino, fin, v);
+    return r.ec == errc() ? r.ptr : nullptr;
+}
+
+template <typename Entero>
+typename enable_if<is_integral<Entero>::value, char*>::type
+escribirValor(char* destino, char* fin, Entero v) {
+    to_chars_result r = to_chars(destino, fin, v);
+    return r.ec == errc() ? r.ptr : nullptr;
+}
+
+inline char* escribirTexto(char* destino, char* fin, const char* texto, size_t longitud) {
+    if (destino == nullptr || (size_t)(fin - destino) < longitud)
+        return nullptr;
+    return copy(texto, texto + longitud, destino);
+}
+
+// Formato "(x, y, z)", igual que operator<<
+template <typename T>
+char* escribirValor(char* destino, char* fin, const Vector3DT<T>& v) {
+    destino = escribirTexto(destino, fin, "(", 1);
+    if (destino) destino = escribirValor(destino, fin, v.getX());
+    destino = escribirTexto(destino, fin, ", ", 2);
+    if (destino) destino = escribirValor(destino, fin, v.getY());
+    destino = escribirTexto(destino, fin, ", ", 2);
+    if (destino) destino = escribirValor(destino, fin, v.getZ());
+    return escribirTexto(destino, fin, ")", 1);
+}
+
+//  CLASE SALIDA EN BLOQUE
+// Acumula resultados formateados en un búfer propio y los envía al archivo
+// con una sola llamada a fwrite cuando se llena o al vaciar, sin forzar la
+// descarga en cada línea.
+class SalidaEnBloque {
+private:
+    FILE* destino;
+    vector<char> bufer;
+    size_t usado;
+    int precision;
+
+    template <typename Valor>
+    char* formatear(char* inicio, char* fin, const Valor& valor) const {
+        return escribirValor(inicio, fin, valor);
+    }
+    char* formatear(char* inicio, char* fin, double valor) const {
+        return escribirValor(inicio, fin, valor, precision);
+    }
+    char* formatear(char* inicio, char* fin, float valor) const {
+        return escribirValor(inicio, fin, valor, precision);
+    }
+
+public:
+    explicit SalidaEnBloque(FILE* destino = stdout, size_t capacidad = 1 << 20)
+        : destino(destino), bufer(capacidad), usado(0), precision(0) {}
+
+    ~SalidaEnBloque() { vaciar(); }
+
+    SalidaEnBloque(const SalidaEnBloque&) = delete;
+    SalidaEnBloque& operator=(const SalidaEnBloque&) = delete;
+
+    // Cifras significativas de los decimales sueltos (0 = la más corta exacta)
+    void setPrecision(int cifras) { precision = cifras; }
+
+    void vaciar() {
+        if (usado > 0)
+            fwrite(bufer.data(), 1, usado, destino);
+        usado = 0;
+        fflush(destino);
+    }
+
+    template <typename Valor>
+    SalidaEnBloque& operator<<(const Valor& valor) {
+        char* inicio = bufer.data() + usado;
+        char* fin = bufer.data() + bufer.size();
+        char* escrito = formatear(inicio, fin, valor);
+        if (escrito == nullptr) {
+            // No cabe en lo que queda: se envía el bloque y se reintenta vacío
+            if (usado > 0)
+                fwrite(bufer.data(), 1, usado, destino);
+            usado = 0;
+            inicio = bufer.data();
+            escrito = formatear(inicio, fin, valor);
+            if (escrito == nullptr) {
+                // Más grande que el búfer completo (solo fracciones enormes)
+                ostringstream texto;
+                texto << valor;
+                string s = texto.str();
+                fwrite(s.data(), 1, s.size(), destino);
+                return *this;
+            }
+        }
+        usado = escrito - bufer.data();
+        return *this;
+    }
+
+    SalidaEnBloque& operator<<(char c) {
+        if (usado == bufer.size()) {
+            fwrite(bufer.data(), 1, usado, destino);
+            usado = 0;
+        }
+        bufer[usado++] = c;
+        return *this;
+    }
+
+    SalidaEnBloque& operator<<(const char* texto) {
+        for (; *texto != '\0'; texto++)
+            *this << *texto;
+        return *this;
+    }
+};
+
+//  OPERACIONES SIMD
+// Envoltorios mínimos sobre AVX, SSE2 o escalar según lo que habilite el
+// compilador (por ejemplo con -mavx2 o -march=native). Los núcleos de
+// LoteVector3D se escriben una sola vez sobre estas funciones.
+namespace simd {
+#if defined(__AVX__)
+typedef __m256d Registro;
+const size_t ANCHO = 4;
+inline Registro cargar(const double* p) { return _mm256_loadu_pd(p); }
+inline void guardar(double* p, Registro v) { _mm256_storeu_pd(p, v); }
+inline Registro repetir(double v) { return _mm256_set1_pd(v); }
+inline Registro sumar(Registro a, Registro b) { return _mm256_add_pd(a, b); }
+inline Registro restar(Registro a, Registro b) { return _mm256_sub_pd(a, b); }
+inline Registro multiplicar(Registro a, Registro b) { return _mm256_mul_pd(a, b); }
+inline Registro dividir(Registro a, Registro b) { return _mm256_div_pd(a, b); }
+inline Registro raiz(Registro a) { return _mm256_sqrt_pd(a); }
+#if defined(__FMA__)
+inline Registro multiplicarSumar(Registro a, Registro b, Registro c) { return _mm256_fmadd_pd(a, b, c); }
+#else
+inline Registro multiplicarSumar(Registro a, Registro b, Registro c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#endif
+// Deja en cero los carriles donde m es cero
+inline Registro anularSiCero(Registro v, Registro m) {
+    return _mm256_and_pd(v, _mm256_cmp_pd(m, _mm256_setzero_pd(), _CMP_NEQ_OQ));
+}
+#elif defined(__SSE2__)
+typedef __m128d Registro;
+const size_t ANCHO = 2;
+inline Registro cargar(const double* p) { return _mm_loadu_pd(p); }
+inline void guardar(double* p, Registro v) { _mm_storeu_pd(p, v); }
+inline Registro repetir(double v) { return _mm_set1_pd(v); }
+inline Registro sumar(Registro a, Registro b) { return _mm_add_pd(a, b); }
+inline Registro restar(Registro a, Registro b) { return _mm_sub_pd(a, b); }
+inline Registro multiplicar(Registro a, Registro b) { return _mm_mul_pd(a, b); }
+inline Registro dividir(Registro a, Registro b) { return _mm_div_pd(a, b); }
+inline Registro raiz(Registro a) { return _mm_sqrt_pd(a); }
+inline Registro multiplicarSumar(Registro a, Registro b, Registro c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+inline Registro anularSiCero(Registro v, Registro m) {
+    return _mm_and_pd(v, _mm_cmpneq_pd(m, _mm_setzero_pd()));
+}
+#else
+typedef double Registro;
+const size_t ANCHO = 1;
+inline Registro cargar(const double* p) { return *p; }
+inline void guardar(double* p, Registro v) { *p = v; }
+inline Registro repetir(double v) { return v; }
+inline Registro sumar(Registro a, Registro b) { return a + b; }
+inline Registro restar(Registro a, Registro b) { return a - b; }
+inline Registro multiplicar(Registro a, Registro b) { return a * b; }
+inline Registro dividir(Registro a, Registro b) { return a / b; }
+inline Registro raiz(Registro a) { return sqrt(a); }
+inline Registro multiplicarSumar(Registro a, Registro b, Registro c) { return a * b + c; }
+inline Registro anularSiCero(Registro v, Registro m) { return m != 0.0 ? v : 0.0; }
+#endif
+
+inline const char* nombreConjunto() {
+#if defined(__AVX__)
+    return "AVX";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "escalar";
+#endif
+}
+}
+
+//  CLASE LOTE DE VECTORES 3D
+// Almacena muchos vectores en formato de estructura de arreglos (x, y, z
+// contiguos en double) para procesarlos con instrucciones SIMD. Los
+// resultados que no son vectores se escriben en un arreglo del llamador.
+class LoteVector3D {
+private:
+    vector<double> x, y, z;
+
+    bool mismoTamano(const LoteVector3D& otro) const {
+        if (otro.tamano() != tamano()) {
+            cerr << "Error: Los lotes deben tener el mismo tamaño.\n";
+            return false;
+        }
+        return true;
+    }
+
+    // a (+/-) b componente a componente
+    static LoteVector3D combinar(const LoteVector3D& a, const LoteVector3D& b, bool resta) {
+        LoteVector3D r(a.tamano());
+        const double* ax[3] = {a.x.data(), a.y.data(), a.z.data()};
+        const double* bx[3] = {b.x.data(), b.y.data(), b.z.data()};
+        double* rx[3] = {r.x.data(), r.y.data(), r.z.data()};
+        const size_t n = a.tamano();
+        for (int c = 0; c < 3; c++) {
+            size_t i = 0;
+            for (; i + simd::ANCHO <= n; i += simd::ANCHO) {
+                simd::Registro va = simd::cargar(ax[c] + i), vb = simd::cargar(bx[c] + i);
+                simd::guardar(rx[c] + i, resta ? simd::restar(va, vb) : simd::sumar(va, vb));
+            }
+            for (; i < n; i++)
+                rx[c][i] = resta ? ax[c][i] - bx[c][i] : ax[c][i] + bx[c][i];
+        }
+        return r;
+    }
+
+public:
+    LoteVector3D() {}
+    explicit LoteVector3D(size_t n) : x(n, 0.0), y(n, 0.0), z(n, 0.0) {}
+
+    // Conversión en bloque desde y hacia Vector3DT de cualquier escalar
+    template <typename T>
+    static LoteVector3D desdeVectores(const vector<Vector3DT<T>>& vectores) {
+        LoteVector3D lote(vectores.size());
+        for (size_t i = 0; i < vectores.size(); i++) {
+            lote.x[i] = RasgosEscalar<T>::aReal(vectores[i].getX());
+            lote.y[i] = RasgosEscalar<T>::aReal(vectores[i].getY());
+            lote.z[i] = RasgosEscalar<T>::aReal(vectores[i].getZ());
+        }
+        return lote;
+    }
+
+    // maxDenominador solo se usa al convertir a Fraccion
+    template <typename T = Fraccion>
+    vector<Vector3DT<T>> aVectores(long long maxDenominador = 1000000) const {
+        vector<Vector3DT<T>> vectores;
+        vectores.reserve(tamano());
+        for (size_t i = 0; i < tamano(); i++)
+            vectores.push_back(Vector3DT<T>(RasgosEscalar<T>::desdeDecimal(x[i], maxDenominador),
+                                            RasgosEscalar<T>::desdeDecimal(y[i], maxDenominador),
+                                            RasgosEscalar<T>::desdeDecimal(z[i], maxDenominador)));
+        return vectores;
+    }
+
+    size_t tamano() const { return x.size(); }
+
+    void agregar(double vx, double vy, double vz) {
+        x.push_back(vx);
+        y.push_back(vy);
+        z.push_back(vz);
+    }
+
+    // Acceso directo a los arreglos para núcleos externos (p. ej. TransformacionFija)
+    double* datosX() { return x.data(); }
+    double* datosY() { return y.data(); }
+    double* datosZ() { return z.data(); }
+
+    double getX(size_t i) const { return x[i]; }
+    double getY(size_t i) const { return y[i]; }
+    double getZ(size_t i) const { return z[i]; }
+
+    // Escribe la magnitud de cada vector en salida (se redimensiona)
+    void magnitudes(vector<double>& salida) const {
+        const size_t n = tamano();
+        salida.resize(n);
+        size_t i = 0;
+        for (; i + simd::ANCHO <= n; i += simd::ANCHO) {
+            simd::Registro vx = simd::cargar(&x[i]), vy = simd::cargar(&y[i]), vz = simd::cargar(&z[i]);
+            simd::Registro cuadrado = simd::multiplicarSumar(vz, vz,
+                                      simd::multiplicarSumar(vy, vy, simd::multiplicar(vx, vx)));
+            simd::guardar(&salida[i], simd::raiz(cuadrado));
+        }
+        for (; i < n; i++)
+            salida[i] = sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+    }
+
+    // Normaliza en sitio; los vectores cero se dejan en cero
+    void normalizar() {
+        const size_t n = tamano();
+        size_t i = 0;
+        for (; i + simd::ANCHO <= n; i += simd::ANCHO) {
+            simd::Registro vx = simd::cargar(&x[i]), vy = simd::cargar(&y[i]), vz = simd::cargar(&z[i]);
+            simd::Registro magnitud = simd::raiz(simd::multiplicarSumar(vz, vz,
+                                      simd::multiplicarSumar(vy, vy, simd::multiplicar(vx, vx))));
+            simd::guardar(&x[i], simd::anularSiCero(simd::dividir(vx, magnitud), magnitud));
+            simd::guardar(&y[i], simd::anularSiCero(simd::dividir(vy, magnitud), magnitud));
+            simd::guardar(&z[i], simd::anularSiCero(simd::dividir(vz, magnitud), magnitud));
+        }
+        for (; i < n; i++) {
+            double magnitud = sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+            if (magnitud != 0.0) {
+                x[i] /= magnitud;
+                y[i] /= magnitud;
+                z[i] /= magnitud;
+            }
+        }
+    }
+
+    // Multiplica todos los vectores por el escalar en sitio
+    void escalar(double factor) {
+        const simd::Registro f = simd::repetir(factor);
+        double* componentes[3] = {x.data(), y.data(), z.data()};
+        const size_t n = tamano();
+        for (double* c : componentes) {
+            size_t i = 0;
+            for (; i + simd::ANCHO <= n; i += simd::ANCHO)
+                simd::guardar(c + i, simd::multiplicar(simd::cargar(c + i), f));
+            for (; i < n; i++)
+                c[i] *= factor;
+        }
+    }
+
+    // Producto escalar de cada par (this[i] · otro[i])
+    void productoEscalar(const LoteVector3D& otro, vector<double>& salida) const {
+        if (!mismoTamano(otro))
+            return;
+        const size_t n = tamano();
+        salida.resize(n);
+        size_t i = 0;
+        for (; i + simd::ANCHO <= n; i += simd::ANCHO) {
+            simd::Registro p = simd::multiplicar(simd::cargar(&x[i]), simd::cargar(&otro.x[i]));
+            p = simd::multiplicarSumar(simd::cargar(&y[i]), simd::cargar(&otro.y[i]), p);
+            p = simd::multiplicarSumar(simd::cargar(&z[i]), simd::cargar(&otro.z[i]), p);
+            simd::guardar(&salida[i], p);
+        }
+        for (; i < n; i++)
+            salida[i] = x[i] * otro.x[i] + y[i] * otro.y[i] + z[i] * otro.z[i];
+    }
+
+    LoteVector3D operator+(const LoteVector3D& otro) const {
+        if (!mismoTamano(otro))
+            return LoteVector3D();
+        return combinar(*this, otro, false);
+    }
+
+    LoteVector3D operator-(const LoteVector3D& otro) const {
+        if (!mismoTamano(otro))
+            return LoteVector3D();
+        return combinar(*this, otro, true);
+    }
+
+    LoteVector3D operator*(double factor) const {
+        LoteVector3D r = *this;
+        r.escalar(factor);
+        return r;
+    }
+};
+
+//  CLASE TRANSFORMACION FIJA
+// Matriz de transformación N x N con el tamaño como parte del tipo: 3x3 para
+// rotaciones y escalas, 4x4 en coordenadas homogéneas para agregar
+// traslación. Los bucles tienen límites constantes y el compilador los
+// desenrolla. Con T = Fraccion la transformación es exacta; con double se
+// aplica sobre un LoteVector3D con los núcleos SIMD.
+template <typename T, int N>
+class TransformacionFija {
+    static_assert(N == 3 || N == 4, "Solo se admiten transformaciones 3x3 y 4x4");
+
+private:
+    T m[N][N];
+
+    typedef RasgosEscalar<T> Rasgos;
+
+public:
+    constexpr TransformacionFija() : m() {}
+
+    static constexpr TransformacionFija identidad() {
+        TransformacionFija r;
+        for (int i = 0; i < N; i++)
+            r.m[i][i] = T(1);
+        return r;
+    }
+
+    // Rotaciones dadas por coseno y seno (con Fraccion sirven ternas pitagóricas, p. ej. 3/5 y 4/5)
+    static constexpr TransformacionFija rotacionX(const T& coseno, const T& seno) {
+        TransformacionFija r = identidad();
+        r.m[1][1] = coseno; r.m[1][2] = -seno;
+        r.m[2][1] = seno;   r.m[2][2] = coseno;
+        return r;
+    }
+
+    static constexpr TransformacionFija rotacionY(const T& coseno, const T& seno) {
+        TransformacionFija r = identidad();
+        r.m[0][0] = coseno; r.m[0][2] = seno;
+        r.m[2][0] = -seno;  r.m[2][2] = coseno;
+        return r;
+    }
+
+    static constexpr TransformacionFija rotacionZ(const T& coseno, const T& seno) {
+        TransformacionFija r = identidad();
+        r.m[0][0] = coseno; r.m[0][1] = -seno;
+        r.m[1][0] = seno;   r.m[1][1] = coseno;
+        return r;
+    }
+
+    static constexpr TransformacionFija escala(const T& sx, const T& sy, const T& sz) {
+        TransformacionFija r = identidad();
+        r.m[0][0] = sx;
+        r.m[1][1] = sy;
+        r.m[2][2] = sz;
+        return r;
+    }
+
+    static constexpr TransformacionFija traslacion(const T& tx, const T& ty, const T& tz) {
+        static_assert(N == 4, "La traslación requiere una transformación 4x4");
+        TransformacionFija r = identidad();
+        r.m[0][N - 1] = tx;
+        r.m[1][N - 1] = ty;
+        r.m[2][N - 1] = tz;
+        return r;
+    }
+
+    constexpr T& operator()(int i, int j) { return m[i][j]; }
+    constexpr const T& operator()(int i, int j) const { return m[i][j]; }
+
+    // Composición: (A * B) aplica primero B y luego A
+    constexpr TransformacionFija operator*(const TransformacionFija& o) const {
+        TransformacionFija r;
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++) {
+                typename Rasgos::Acumulador suma;
+                for (int k = 0; k < N; k++)
+                    suma.sumarProducto(m[i][k], o.m[k][j]);
+                r.m[i][j] = suma.resultado();
+            }
+        return r;
+    }
+
+    // En 4x4, afín si la última fila es (0, 0, 0, 1) y no hace falta dividir por w
+    constexpr bool esAfin() const {
+        if constexpr (N == 3) {
+            return true;
+        } else {
+            return m[3][0] == T(0) && m[3][1] == T(0) && m[3][2] == T(0) && m[3][3] == T(1);
+        }
+    }
+
+    constexpr Vector3DT<T> aplicar(const Vector3DT<T>& v) const {
+        T r[N];
+        for (int i = 0; i < N; i++) {
+            typename Rasgos::Acumulador suma;
+            suma.sumarProducto(m[i][0], v.getX());
+            suma.sumarProducto(m[i][1], v.getY());
+            suma.sumarProducto(m[i][2], v.getZ());
+            if constexpr (N == 4)
+                suma.sumar(m[i][3]);
+            r[i] = suma.resultado();
+        }
+        if constexpr (N == 4) {
+            if (!(r[3] == T(1)))
+                return Vector3DT<T>(r[0] / r[3], r[1] / r[3], r[2] / r[3]);
+        }
+        return Vector3DT<T>(r[0], r[1], r[2]);
+    }
+
+    // Aplica a una colección contigua; salida puede ser la misma que entrada
+    void aplicar(const vector<Vector3DT<T>>& entrada, vector<Vector3DT<T>>& salida) const {
+        salida.resize(entrada.size());
+        for (size_t i = 0; i < entrada.size(); i++)
+            salida[i] = aplicar(entrada[i]);
+    }
+
+    // Núcleo en double sobre el lote SoA, en sitio. Los coeficientes se
+    // replican una vez en registros y cada vuelta procesa simd::ANCHO puntos.
+    void aplicarEnSitio(LoteVector3D& lote) const {
+        double c[4][4] = {};
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                c[i][j] = (double)Rasgos::aReal(m[i][j]);
+        if (N == 3)
+            c[3][3] = 1.0;
+        const bool proyectiva = !esAfin();
+
+        simd::Registro a[4][4];
+        for (int i = 0; i < 4; i++)
+            for (int j = 0; j < 4; j++)
+                a[i][j] = simd::repetir(c[i][j]);
+
+        double* px = lote.datosX();
+        double* py = lote.datosY();
+        double* pz = lote.datosZ();
+        const size_t n = lote.tamano();
+        size_t i = 0;
+        for (; i + simd::ANCHO <= n; i += simd::ANCHO) {
+            simd::Registro vx = simd::cargar(px + i), vy = simd::cargar(py + i), vz = simd::cargar(pz + i);
+            simd::Registro r[3];
+            for (int f = 0; f < 3; f++)
+                r[f] = simd::multiplicarSumar(a[f][0], vx, simd::multiplicarSumar(a[f][1], vy,
+                       simd::multiplicarSumar(a[f][2], vz, a[f][3])));
+            if (proyectiva) {
+                simd::Registro w = simd::multiplicarSumar(a[3][0], vx, simd::multiplicarSumar(a[3][1], vy,
+                                   simd::multiplicarSumar(a[3][2], vz, a[3][3])));
+                for (int f = 0; f < 3; f++)
+                    r[f] = simd::dividir(r[f], w);
+            }
+            simd::guardar(px + i, r[0]);
+            simd::guardar(py + i, r[1]);
+            simd::guardar(pz + i, r[2]);
+        }
+        for (; i < n; i++) {
+            double x = px[i], y = py[i], z = pz[i];
+            double w = proyectiva ? c[3][0] * x + c[3][1] * y + c[3][2] * z + c[3][3] : 1.0;
+            px[i] = (c[0][0] * x + c[0][1] * y + c[0][2] * z + c[0][3]) / w;
+            py[i] = (c[1][0] * x + c[1][1] * y + c[1][2] * z + c[1][3]) / w;
+            pz[i] = (c[2][0] * x + c[2][1] * y + c[2][2] * z + c[2][3]) / w;
+        }
+    }
+
+    void imprimir(const string& etiqueta = "T") const {
+        cout << etiqueta << " (" << N << "x" << N << "):" << endl;
+        for (int i = 0; i < N; i++) {
+            cout << "[ ";
+            for (int j = 0; j < N; j++) {
+                ostringstream celda;
+                celda << m[i][j];
+                cout << setw(8) << celda.str() << (j < N - 1 ? ", " : "");
+            }
+            cout << " ]" << endl;
+        }
+    }
+};
+
+template <typename T>
+using Transformacion3 = TransformacionFija<T, 3>;
+
+template <typename T>
+using Transformacion4 = TransformacionFija<T, 4>;
+
+// Giro exacto con la terna pitagórica (3, 4, 5) seguido de una traslación
+constexpr Transformacion4<Fraccion> GIRO_3_4_5 = Transformacion4<Fraccion>::rotacionZ(Fraccion(3, 5), Fraccion(4, 5));
+constexpr Transformacion4<Fraccion> TRASLACION_1_2_3 = Transformacion4<Fraccion>::traslacion(1, 2, 3);
+constexpr Transformacion4<Fraccion> GIRO_Y_TRASLACION = TRASLACION_1_2_3 * GIRO_3_4_5;
+static_assert(GIRO_Y_TRASLACION.aplicar(EJE_X) * DIAGONAL == Fraccion(37, 5),
+              "(3/5 + 1) + (4/5 + 2) + (0 + 3) = 37/5");
+
+//  CLASE GRUPO DE HILOS
+// Conjunto fijo de hilos que atiende una cola de tareas. Se crea una vez y
+// se reutiliza en todas las reducciones para no pagar la creación de hilos
+// en cada llamada.
+class GrupoHilos {
+private:
+    vector<thread> hilos;
+    queue<function<void()>> tareas;
+    mutex cerrojo;
+    condition_variable hayTrabajo;
+    condition_variable sinPendientes;
+    size_t pendientes;
+    bool detener;
+
+    void trabajar() {
+        while (true) {
+            function<void()> tarea;
+            {
+                unique_lock<mutex> lock(cerrojo);
+                hayTrabajo.wait(lock, [this]() { return detener || !tareas.empty(); });
+                if (detener && tareas.empty())
+                    return;
+                tarea = move(tareas.front());
+                tareas.pop();
+            }
+            tarea();
+            {
+                lock_guard<mutex> lock(cerrojo);
+                if (--pendientes == 0)
+                    sinPendientes.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit GrupoHilos(unsigned cantidad = thread::hardware_concurrency())
+        : pendientes(0), detener(false) {
+        if (cantidad == 0)
+            cantidad = 1;
+        for (unsigned i = 0; i < cantidad; i++)
+            hilos.emplace_back(&GrupoHilos::trabajar, this);
+    }
+
+    ~GrupoHilos() {
+        {
+            lock_guard<mutex> lock(cerrojo);
+            detener = true;
+        }
+        hayTrabajo.notify_all();
+        for (thread& h : hilos)
+            h.join();
+    }
+
+    GrupoHilos(const GrupoHilos&) = delete;
+    GrupoHilos& operator=(const GrupoHilos&) = delete;
+
+    unsigned tamano() const { return (unsigned)hilos.size(); }
+
+    void encolar(function<void()> tarea) {
+        {
+            lock_guard<mutex> lock(cerrojo);
+            tareas.push(move(tarea));
+            pendientes++;
+        }
+        hayTrabajo.notify_one();
+    }
+
+    void esperar() {
+        unique_lock<mutex> lock(cerrojo);
+        sinPendientes.wait(lock, [this]() { return pendientes == 0; });
+    }
+
+    // Divide [0, n) en 'bloques' tramos contiguos, ejecuta
+    // funcion(inicio, fin, bloque) para cada uno y espera a que terminen
+    template <typename Funcion>
+    void paraCadaBloque(size_t n, size_t bloques, Funcion funcion) {
+        if (bloques == 0)
+            bloques = 1;
+        for (size_t b = 0; b < bloques; b++) {
+            size_t inicio = n * b / bloques;
+            size_t fin = n * (b + 1) / bloques;
+            encolar([=]() { funcion(inicio, fin, b); });
+        }
+        esperar();
+    }
+};
+
+//  CLASE ARBOL KD
+// Índice espacial para consultas de vecinos más cercanos y por radio. El
+// árbol es implícito sobre un arreglo plano: el nodo del tramo [inicio, fin)
+// es el punto en la mitad, con los menores a la izquierda y los mayores a
+// la derecha según su eje de corte. No hay punteros entre nodos y los tramos
+// pequeños se recorren como hojas de forma lineal.
+struct Vecino {
+    size_t indice;          // Posición del punto en la colección original
+    double distancia;
+};
+
+class ArbolKD {
+private:
+    struct Punto {
+        double c[3];
+        size_t indice;
+    };
+
+    static const size_t TAM_HOJA = 8;
+
+    vector<Punto> puntos;
+    vector<unsigned char> ejes;     // Eje de corte de cada nodo, indexado por su posición
+
+    // La construcción recorre cada nivel una vez (O(n) por nivel)
+    void construir(size_t inicio, size_t fin) {
+        if (fin - inicio <= TAM_HOJA)
+            return;
+        double minimo[3], maximo[3];
+        for (int e = 0; e < 3; e++)
+            minimo[e] = maximo[e] = puntos[inicio].c[e];
+        for (size_t i = inicio + 1; i < fin; i++)
+            for (int e = 0; e < 3; e++) {
+                minimo[e] = min(minimo[e], puntos[i].c[e]);
+                maximo[e] = max(maximo[e], puntos[i].c[e]);
+            }
+        int eje = 0;
+        for (int e = 1; e < 3; e++)
+            if (maximo[e] - minimo[e] > maximo[eje] - minimo[eje])
+                eje = e;
+
+        size_t medio = inicio + (fin - inicio) / 2;
+        nth_element(puntos.begin() + inicio, puntos.begin() + medio, puntos.begin() + fin,
+                    [eje](const Punto& a, const Punto& b) { return a.c[eje] < b.c[eje]; });
+        ejes[medio] = (unsigned char)eje;
+        construir(inicio, medio);
+        construir(medio + 1, fin);
+    }
+
+    static double distancia2(const Punto& p, const double q[3]) {
+        double dx = p.c[0] - q[0], dy = p.c[1] - q[1], dz = p.c[2] - q[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // Montículo de máximos con los k mejores candidatos (distancia al cuadrado)
+    struct Candidatos {
+        vector<pair<double, size_t>> monticulo;
+        size_t k;
+
+        double peor() const {
+            return monticulo.size() < k ? numeric_limits<double>::infinity() : monticulo.front().first;
+        }
+
+        void ofrecer(double d2, size_t indice) {
+            if (monticulo.size() < k) {
+                monticulo.push_back(make_pair(d2, indice));
+                push_heap(monticulo.begin(), monticulo.end());
+            } else if (d2 < monticulo.front().first) {
+                pop_heap(monticulo.begin(), monticulo.end());
+                monticulo.back() = make_pair(d2, indice);
+                push_heap(monticulo.begin(), monticulo.end());
+            }
+        }
+    };
+
+    void buscarCercanos(size_t inicio, size_t fin, const double q[3], Candidatos& c) const {
+        if (fin - inicio <= TAM_HOJA) {
+            for (size_t i = inicio; i < fin; i++)
+                c.ofrecer(distancia2(puntos[i], q), puntos[i].indice);
+            return;
+        }
+        size_t medio = inicio + (fin - inicio) / 2;
+        const Punto& p = puntos[medio];
+        double d = q[ejes[medio]] - p.c[ejes[medio]];
+        c.ofrecer(distancia2(p, q), p.indice);
+        // Primero el lado que contiene la consulta; el otro solo si puede mejorar
+        if (d < 0) {
+            buscarCercanos(inicio, medio, q, c);
+            if (d * d < c.peor())
+                buscarCercanos(medio + 1, fin, q, c);
+        } else {
+            buscarCercanos(medio + 1, fin, q, c);
+            if (d * d < c.peor())
+                buscarCercanos(inicio, medio, q, c);
+        }
+    }
+
+    void buscarRadio(size_t inicio, size_t fin, const double q[3], double r2, vector<Vecino>& salida) const {
+        if (fin - inicio <= TAM_HOJA) {
+            for (size_t i = inicio; i < fin; i++) {
+                double d2 = distancia2(puntos[i], q);
+                if (d2 <= r2)
+                    salida.push_back(Vecino{puntos[i].indice, sqrt(d2)});
+            }
+            return;
         }
+        size_t medio = inicio + (fin - inicio) / 2;
+        const Punto& p = puntos[medio];
+        double d = q[ejes[medio]] - p.c[ejes[medio]];
+        double d2 = distancia2(p, q);
+        if (d2 <= r2)
+            salida.push_back(Vecino{p.indice, sqrt(d2)});
+        if (d <= 0 || d * d <= r2)
+            buscarRadio(inicio, medio, q, r2, salida);
+        if (d >= 0 || d * d <= r2)
+            buscarRadio(medio + 1, fin, q, r2, salida);
     }
 
-public:
-    Fraccion() : numerador(0), denominador(1) {}
-    Fraccion(int n) : numerador(n), denominador(1) {}
-    Fraccion(int n, int d) : numerador(n), denominador(d) {
-        simplificar();
+    static bool porDistancia(const Vecino& a, const Vecino& b) {
+        return a.distancia < b.distancia || (a.distancia == b.distancia && a.indice < b.indice);
     }
-    
-    int getNumerador() const { return numerador; }
-    int getDenominador() const { return denominador; }
-    
-    double aDecimal() const {
-        return static_cast<double>(numerador) / denominador;
+
+    void indexar() {
+        ejes.assign(puntos.size(), 0);
+        construir(0, puntos.size());
     }
-    
-    Fraccion operator+(const Fraccion& f) const {
-        return Fraccion(numerador * f.denominador + f.numerador * denominador,
-                       denominador * f.denominador);
+
+public:
+    ArbolKD() {}
+
+    template <typename T>
+    explicit ArbolKD(const vector<Vector3DT<T>>& vectores) : puntos(vectores.size()) {
+        for (size_t i = 0; i < vectores.size(); i++) {
+            puntos[i].c[0] = RasgosEscalar<T>::aReal(vectores[i].getX());
+            puntos[i].c[1] = RasgosEscalar<T>::aReal(vectores[i].getY());
+            puntos[i].c[2] = RasgosEscalar<T>::aReal(vectores[i].getZ());
+            puntos[i].indice = i;
+        }
+        indexar();
     }
-    
-    Fraccion operator-(const Fraccion& f) const {
-        return Fraccion(numerador * f.denominador - f.numerador * denominador,
-                       denominador * f.denominador);
+
+    explicit ArbolKD(const LoteVector3D& lote) : puntos(lote.tamano()) {
+        for (size_t i = 0; i < lote.tamano(); i++) {
+            puntos[i].c[0] = lote.getX(i);
+            puntos[i].c[1] = lote.getY(i);
+            puntos[i].c[2] = lote.getZ(i);
+            puntos[i].indice = i;
+        }
+        indexar();
     }
-    
-    Fraccion operator*(const Fraccion& f) const {
-        return Fraccion(numerador * f.numerador, denominador * f.denominador);
+
+    size_t tamano() const { return puntos.size(); }
+
+    // Los k puntos más cercanos a (x, y, z), ordenados por distancia
+    vector<Vecino> kCercanos(double x, double y, double z, size_t k) const {
+        const double q[3] = {x, y, z};
+        Candidatos c;
+        c.k = k;
+        c.monticulo.reserve(k);
+        if (k > 0 && !puntos.empty())
+            buscarCercanos(0, puntos.size(), q, c);
+        vector<Vecino> resultado;
+        resultado.reserve(c.monticulo.size());
+        for (const pair<double, size_t>& m : c.monticulo)
+            resultado.push_back(Vecino{m.second, sqrt(m.first)});
+        sort(resultado.begin(), resultado.end(), porDistancia);
+        return resultado;
     }
-    
-    Fraccion operator/(const Fraccion& f) const {
-        return Fraccion(numerador * f.denominador, denominador * f.numerador);
+
+    // Todos los puntos a distancia <= radio de (x, y, z), ordenados por distancia
+    vector<Vecino> enRadio(double x, double y, double z, double radio) const {
+        const double q[3] = {x, y, z};
+        vector<Vecino> resultado;
+        if (radio >= 0 && !puntos.empty())
+            buscarRadio(0, puntos.size(), q, radio * radio, resultado);
+        sort(resultado.begin(), resultado.end(), porDistancia);
+        return resultado;
     }
-    
-    Fraccion operator-() const {
-        return Fraccion(-numerador, denominador);
+
+    template <typename T>
+    vector<Vecino> kCercanos(const Vector3DT<T>& v, size_t k) const {
+        return kCercanos(RasgosEscalar<T>::aReal(v.getX()), RasgosEscalar<T>::aReal(v.getY()),
+                         RasgosEscalar<T>::aReal(v.getZ()), k);
     }
-    
-    bool operator==(const Fraccion& f) const {
-        return numerador * f.denominador == f.numerador * denominador;
+
+    template <typename T>
+    vector<Vecino> enRadio(const Vector3DT<T>& v, double radio) const {
+        return enRadio(RasgosEscalar<T>::aReal(v.getX()), RasgosEscalar<T>::aReal(v.getY()),
+                       RasgosEscalar<T>::aReal(v.getZ()), radio);
     }
-    
-    double raizCuadrada() const {
-        return sqrt(aDecimal());
+
+    // Consultas en lote repartidas entre los hilos del grupo
+    vector<vector<Vecino>> kCercanosLote(const LoteVector3D& consultas, size_t k, GrupoHilos& grupo) const {
+        vector<vector<Vecino>> resultado(consultas.tamano());
+        grupo.paraCadaBloque(consultas.tamano(), (size_t)grupo.tamano() * 4,
+                             [&](size_t inicio, size_t fin, size_t) {
+            for (size_t i = inicio; i < fin; i++)
+                resultado[i] = kCercanos(consultas.getX(i), consultas.getY(i), consultas.getZ(i), k);
+        });
+        return resultado;
     }
-    
-    void imprimir() const {
-        if (denominador == 1) {
-            cout << numerador;
-        } else {
-            cout << numerador << "/" << denominador;
+
+    vector<vector<Vecino>> enRadioLote(const LoteVector3D& consultas, double radio, GrupoHilos& grupo) const {
+        vector<vector<Vecino>> resultado(consultas.tamano());
+        grupo.paraCadaBloque(consultas.tamano(), (size_t)grupo.tamano() * 4,
+                             [&](size_t inicio, size_t fin, size_t) {
+            for (size_t i = inicio; i < fin; i++)
+                resultado[i] = enRadio(consultas.getX(i), consultas.getY(i), consultas.getZ(i), radio);
+        });
+        return resultado;
+    }
+};
+
+//  REDUCCIONES PARALELAS
+// Cada hilo suma su tramo con un AcumuladorFraccion por componente, que
+// trabaja sobre un denominador común sin simplificar. Las sumas parciales se
+// combinan después con aritmética exacta, así que el resultado no depende
+// del número de hilos.
+
+Vector3D sumaParalela(const vector<Vector3D>& vectores, GrupoHilos& grupo) {
+    // Pocos tramos por hilo para balancear sin multiplicar las fusiones
+    size_t bloques = min(vectores.size() / 4096 + 1, (size_t)grupo.tamano() * 4);
+    vector<Vector3D> parciales(bloques);
+    grupo.paraCadaBloque(vectores.size(), bloques, [&](size_t inicio, size_t fin, size_t b) {
+        AcumuladorFraccion sx, sy, sz;
+        for (size_t i = inicio; i < fin; i++) {
+            sx.sumar(vectores[i].getX());
+            sy.sumar(vectores[i].getY());
+            sz.sumar(vectores[i].getZ());
         }
+        parciales[b] = Vector3D(sx.resultado(), sy.resultado(), sz.resultado());
+    });
+    return Vector3D::sumarTodos(parciales);
+}
+
+Vector3D centroideParalelo(const vector<Vector3D>& vectores, GrupoHilos& grupo) {
+    if (vectores.empty()) {
+        cerr << "Error: No hay vectores para calcular el centroide.\n";
+        return Vector3D();
     }
-    
-    string aString() const {
-        if (denominador == 1) {
-            return to_string(numerador);
-        } else {
-            return to_string(numerador) + "/" + to_string(denominador);
+    return sumaParalela(vectores, grupo) * Fraccion(1, (long long)vectores.size());
+}
+
+// Matriz a.size() x b.size() (por filas) con a[i] · b[j]
+vector<Fraccion> matrizProductosEscalares(const vector<Vector3D>& a, const vector<Vector3D>& b,
+                                          GrupoHilos& grupo) {
+    vector<Fraccion> resultado(a.size() * b.size());
+    size_t bloques = min(a.size(), (size_t)grupo.tamano() * 8);
+    grupo.paraCadaBloque(a.size(), bloques, [&](size_t inicio, size_t fin, size_t) {
+        for (size_t i = inicio; i < fin; i++)
+            for (size_t j = 0; j < b.size(); j++)
+                resultado[i * b.size() + j] = a[i] * b[j];
+    });
+    return resultado;
+}
+
+// Matriz de Gram (v[i] · v[j]); solo calcula el triángulo superior y lo refleja.
+// Las filas se reparten intercaladas porque las primeras tienen más trabajo.
+vector<Fraccion> matrizGram(const vector<Vector3D>& vectores, GrupoHilos& grupo) {
+    const size_t n = vectores.size();
+    vector<Fraccion> resultado(n * n);
+    const size_t bloques = min(n, (size_t)grupo.tamano() * 8);
+    grupo.paraCadaBloque(bloques, bloques, [&](size_t b, size_t, size_t) {
+        for (size_t i = b; i < n; i += bloques)
+            for (size_t j = i; j < n; j++) {
+                Fraccion p = vectores[i] * vectores[j];
+                resultado[j * n + i] = p;
+                resultado[i * n + j] = move(p);
+            }
+    });
+    return resultado;
+}
+
+//  FUNCIONES AUXILIARES 
+
+// Interpreta "a/b" o "a" en [inicio, fin) sin crear cadenas temporales.
+// Devuelve false si el texto no es una fracción válida de 64 bits.
+bool analizarFraccion(const char* inicio, const char* fin, Fraccion& resultado) {
+    if (fin - inicio > 1 && *inicio == '+' && inicio[1] != '-')
+        inicio++;
+    long long num = 0, den = 1;
+    from_chars_result r = from_chars(inicio, fin, num);
+    if (r.ec != errc() || num == LLONG_MIN)
+        return false;
+    if (r.ptr != fin) {
+        if (*r.ptr != '/')
+            return false;
+        const char* inicioDen = r.ptr + 1;
+        if (fin - inicioDen > 1 && *inicioDen == '+' && inicioDen[1] != '-')
+            inicioDen++;
+        r = from_chars(inicioDen, fin, den);
+        if (r.ec != errc() || r.ptr != fin || den == 0 || den == LLONG_MIN)
+            return false;
+    }
+    resultado = Fraccion(num, den);
+    return true;
+}
+
+// Función para leer una fracción desde el teclado
+Fraccion leerFraccion(const string& mensaje) {
+    string input;
+    Fraccion f;
+    cout << mensaje;
+    while (cin >> input && !analizarFraccion(input.data(), input.data() + input.size(), f))
+        cout << "Entrada invalida, intente de nuevo: ";
+    return f;
+}
+
+// Función para leer un vector desde el teclado
+Vector3D leerVector(const string& mensaje) {
+    cout << mensaje << endl;
+    Fraccion x = leerFraccion("  Componente X (ej: 2/3 o 5): ");
+    Fraccion y = leerFraccion("  Componente Y (ej: 1/2 o -3): ");
+    Fraccion z = leerFraccion("  Componente Z (ej: -5/2 o 0): ");
+    return Vector3D(x, y, z);
+}
+
+//  CLASE LECTOR DE FRACCIONES
+// Lee fracciones "a/b" separadas por espacios, comas o punto y coma desde un
+// archivo (o stdin) o desde un bloque de memoria. El archivo se lee por
+// bloques en un único búfer reservado al construir, y cada token se
+// interpreta en su lugar con from_chars, sin cadenas temporales.
+class LectorFracciones {
+private:
+    FILE* archivo;
+    vector<char> propio;    // Búfer de lectura cuando la fuente es un archivo
+    const char* datos;
+    size_t inicio;
+    size_t fin;
+    bool agotado;
+    long long tokensInvalidos;
+
+    static bool esSeparador(char c) {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',' || c == ';';
+    }
+
+    // Mueve lo no consumido al principio del búfer y lo completa desde el archivo
+    bool rellenar() {
+        if (agotado)
+            return false;
+        size_t pendiente = fin - inicio;
+        if (pendiente == propio.size())
+            return false;   // Token más largo que el búfer
+        memmove(propio.data(), propio.data() + inicio, pendiente);
+        size_t leidos = fread(propio.data() + pendiente, 1, propio.size() - pendiente, archivo);
+        inicio = 0;
+        fin = pendiente + leidos;
+        if (leidos == 0)
+            agotado = true;
+        return leidos > 0;
+    }
+
+    // Salta un token que no cabe en el búfer hasta el siguiente separador
+    void descartarToken() {
+        while (true) {
+            inicio = fin;
+            if (!rellenar())
+                return;
+            while (inicio < fin && !esSeparador(datos[inicio]))
+                inicio++;
+            if (inicio < fin)
+                return;
         }
     }
-    
-    friend ostream& operator<<(ostream& os, const Fraccion& f) {
-        if (f.denominador == 1) {
-            os << f.numerador;
-        } else {
-            os << f.numerador << "/" << f.denominador;
+
+public:
+    explicit LectorFracciones(FILE* archivo, size_t capacidad = 1 << 20)
+        : archivo(archivo), propio(capacidad), datos(propio.data()),
+          inicio(0), fin(0), agotado(false), tokensInvalidos(0) {}
+
+    LectorFracciones(const char* texto, size_t longitud)
+        : archivo(nullptr), datos(texto), inicio(0), fin(longitud),
+          agotado(true), tokensInvalidos(0) {}
+
+    long long getTokensInvalidos() const { return tokensInvalidos; }
+
+    // Lee la siguiente fracción válida; los tokens inválidos se cuentan y se saltan
+    bool siguiente(Fraccion& f) {
+        while (true) {
+            while (true) {
+                while (inicio < fin && esSeparador(datos[inicio]))
+                    inicio++;
+                if (inicio < fin || !rellenar())
+                    break;
+            }
+            if (inicio >= fin)
+                return false;
+
+            size_t finToken = inicio;
+            bool cabe = true;
+            while (true) {
+                while (finToken < fin && !esSeparador(datos[finToken]))
+                    finToken++;
+                if (finToken < fin)
+                    break;
+                // rellenar() puede mover el token al principio del búfer
+                size_t desplazamiento = finToken - inicio;
+                bool hayMas = rellenar();
+                finToken = inicio + desplazamiento;
+                if (!hayMas) {
+                    cabe = agotado;
+                    break;
+                }
+            }
+
+            if (!cabe) {
+                descartarToken();
+                tokensInvalidos++;
+                continue;
+            }
+
+            bool valido = analizarFraccion(datos + inicio, datos + finToken, f);
+            inicio = finToken;
+            if (valido)
+                return true;
+            tokensInvalidos++;
         }
-        return os;
+    }
+
+    bool siguienteVector(Vector3D& v) {
+        Fraccion x, y, z;
+        if (!siguiente(x) || !siguiente(y) || !siguiente(z))
+            return false;
+        v = Vector3D(x, y, z);
+        return true;
     }
 };
 
-//  CLASE VECTOR3D 
-class Vector3D {
-private:
-    Fraccion x, y, z;
+// Modo no interactivo: procesa todos los vectores de la entrada y escribe un
+// resultado por línea. Uso: punto1 --flujo <operacion> [archivo]
+int ejecutarFlujo(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Uso: " << argv[0] << " --flujo <magnitud|normalizar|suma|escalar> [archivo]\n"
+             << "  magnitud    magnitud de cada vector\n"
+             << "  normalizar  vector normalizado (decimal) de cada vector\n"
+             << "  suma        suma exacta de todos los vectores\n"
+             << "  escalar     producto escalar de cada par consecutivo de vectores\n";
+        return 1;
+    }
+    string operacion = argv[2];
+    if (operacion != "magnitud" && operacion != "normalizar" &&
+        operacion != "suma" && operacion != "escalar") {
+        cerr << "Error: Operacion desconocida: " << operacion << "\n";
+        return 1;
+    }
 
-public:
-    Vector3D() : x(0), y(0), z(0) {}
-    Vector3D(Fraccion x, Fraccion y, Fraccion z) : x(x), y(y), z(z) {}
-    Vector3D(int x, int y, int z) : x(Fraccion(x)), y(Fraccion(y)), z(Fraccion(z)) {}
-    Vector3D(int xn, int xd, int yn, int yd, int zn, int zd) 
-        : x(Fraccion(xn, xd)), y(Fraccion(yn, yd)), z(Fraccion(zn, zd)) {}
-    
-    Fraccion getX() const { return x; }
-    Fraccion getY() const { return y; }
-    Fraccion getZ() const { return z; }
-    
-    double magnitud() const {
-        double mx = x.aDecimal();
-        double my = y.aDecimal();
-        double mz = z.aDecimal();
-        return sqrt(mx*mx + my*my + mz*mz);
+    FILE* archivo = stdin;
+    if (argc >= 4) {
+        archivo = fopen(argv[3], "rb");
+        if (archivo == nullptr) {
+            cerr << "Error: No se pudo abrir " << argv[3] << "\n";
+            return 1;
+        }
     }
-    
-    void normalizarYMostrar() const {
-        double mag = magnitud();
-        if (mag == 0.0) {
-            cout << "No se puede normalizar el vector cero" << endl;
-            return;
+
+    // Los resultados se acumulan en un solo búfer y se escriben en bloque
+    SalidaEnBloque salida(stdout);
+    salida.setPrecision(10);
+    LectorFracciones lector(archivo);
+    AcumuladorFraccion sx, sy, sz;
+    Vector3D v, anterior;
+    long long leidos = 0;
+
+    while (lector.siguienteVector(v)) {
+        leidos++;
+        if (operacion == "magnitud") {
+            salida << v.magnitud() << '\n';
+        } else if (operacion == "normalizar") {
+            double m = v.magnitud();
+            if (m == 0.0)
+                salida << "0 0 0\n";
+            else
+                salida << v.getX().aDecimal() / m << ' ' << v.getY().aDecimal() / m << ' '
+                       << v.getZ().aDecimal() / m << '\n';
+        } else if (operacion == "suma") {
+            sx.sumar(v.getX());
+            sy.sumar(v.getY());
+            sz.sumar(v.getZ());
+        } else if (leidos % 2 == 0) {
+            salida << anterior * v << '\n';
+        } else {
+            anterior = v;
         }
-        cout << "Vector normalizado (decimal): (" 
-             << x.aDecimal()/mag << ", " 
-             << y.aDecimal()/mag << ", " 
-             << z.aDecimal()/mag << ")" << endl;
     }
-    
-    Vector3D operator+(const Vector3D& v) const {
-        return Vector3D(x + v.x, y + v.y, z + v.z);
+
+    if (operacion == "suma")
+        salida << Vector3D(sx.resultado(), sy.resultado(), sz.resultado()) << '\n';
+    salida.vaciar();
+
+    if (archivo != stdin)
+        fclose(archivo);
+    if (lector.getTokensInvalidos() > 0)
+        cerr << "Aviso: " << lector.getTokensInvalidos() << " tokens invalidos ignorados\n";
+    return 0;
+}
+
+//  PRUEBAS DE RENDIMIENTO
+
+// Fracción original con int de 32 bits y sin control de desbordamiento.
+// Solo se conserva como referencia para las pruebas de rendimiento.
+struct FraccionInt {
+    int numerador;
+    int denominador;
+
+    FraccionInt(int n = 0, int d = 1) : numerador(n), denominador(d) {
+        if (denominador < 0) {
+            numerador = -numerador;
+            denominador = -denominador;
+        }
+        int a = abs(numerador), b = denominador;
+        while (b != 0) {
+            int temp = b;
+            b = a % b;
+            a = temp;
+        }
+        if (a > 1) {
+            numerador /= a;
+            denominador /= a;
+        }
     }
-    
-    Vector3D operator-(const Vector3D& v) const {
-        return Vector3D(x - v.x, y - v.y, z - v.z);
+
+    FraccionInt operator+(const FraccionInt& f) const {
+        return FraccionInt(numerador * f.denominador + f.numerador * denominador,
+                           denominador * f.denominador);
     }
-    
-    Fraccion operator*(const Vector3D& v) const {
+
+    FraccionInt operator*(const FraccionInt& f) const {
+        return FraccionInt(numerador * f.numerador, denominador * f.denominador);
+    }
+
+    string aString() const {
+        return denominador == 1 ? to_string(numerador)
+                                : to_string(numerador) + "/" + to_string(denominador);
+    }
+};
+
+struct Vector3DInt {
+    FraccionInt x, y, z;
+
+    Vector3DInt operator+(const Vector3DInt& v) const {
+        return Vector3DInt{x + v.x, y + v.y, z + v.z};
+    }
+
+    FraccionInt operator*(const Vector3DInt& v) const {
         return x * v.x + y * v.y + z * v.z;
     }
-    
-    Vector3D operator*(const Fraccion& f) const {
-        return Vector3D(x * f, y * f, z * f);
+};
+
+// Ejecuta la función dada y devuelve el tiempo transcurrido en segundos
+template <typename Funcion>
+double medirSegundos(Funcion funcion) {
+    auto inicio = chrono::steady_clock::now();
+    funcion();
+    auto fin = chrono::steady_clock::now();
+    return chrono::duration<double>(fin - inicio).count();
+}
+
+// Compara la Fraccion actual con la versión int en cadenas largas de
+// sumas y productos escalares de Vector3D
+void pruebaRendimientoFraccion() {
+    struct Escenario {
+        const char* descripcion;
+        int maxDenominador;
+        int longitud;
+    };
+    const Escenario escenarios[] = {
+        {"denominadores 1..9", 9, 1000000},
+        {"denominadores 1..1000", 1000, 3000},
+    };
+
+    mt19937 generador(42);
+    cout << fixed << setprecision(1);
+    for (const Escenario& e : escenarios) {
+        uniform_int_distribution<int> numeradores(-9, 9);
+        uniform_int_distribution<int> denominadores(1, e.maxDenominador);
+
+        vector<Vector3D> vectores;
+        vector<Vector3DInt> vectoresInt;
+        vectores.reserve(e.longitud);
+        vectoresInt.reserve(e.longitud);
+        for (int i = 0; i < e.longitud; i++) {
+            int c[6];
+            for (int k = 0; k < 6; k += 2) {
+                c[k] = numeradores(generador);
+                c[k + 1] = denominadores(generador);
+            }
+            vectores.push_back(Vector3D(c[0], c[1], c[2], c[3], c[4], c[5]));
+            vectoresInt.push_back(Vector3DInt{FraccionInt(c[0], c[1]),
+                                              FraccionInt(c[2], c[3]),
+                                              FraccionInt(c[4], c[5])});
+        }
+
+        Vector3D suma;
+        Vector3DInt sumaInt;
+        Fraccion escalar;
+        FraccionInt escalarInt;
+
+        double tSuma = medirSegundos([&]() {
+            for (const Vector3D& v : vectores) suma = suma + v;
+        });
+        double tSumaInt = medirSegundos([&]() {
+            for (const Vector3DInt& v : vectoresInt) sumaInt = sumaInt + v;
+        });
+        double tEscalar = medirSegundos([&]() {
+            for (size_t i = 1; i < vectores.size(); i++)
+                escalar = escalar + vectores[i - 1] * vectores[i];
+        });
+        double tEscalarInt = medirSegundos([&]() {
+            for (size_t i = 1; i < vectoresInt.size(); i++)
+                escalarInt = escalarInt + vectoresInt[i - 1] * vectoresInt[i];
+        });
+
+        bool sumaCorrecta = suma.getX().aString() == sumaInt.x.aString() &&
+                            suma.getY().aString() == sumaInt.y.aString() &&
+                            suma.getZ().aString() == sumaInt.z.aString();
+        bool escalarCorrecto = escalar.aString() == escalarInt.aString();
+
+        cout << "\nEscenario: " << e.descripcion << ", " << e.longitud << " vectores" << endl;
+        cout << "  Suma encadenada     Fraccion: " << setw(9) << tSuma * 1e9 / e.longitud
+             << " ns/op   int: " << setw(9) << tSumaInt * 1e9 / e.longitud << " ns/op"
+             << (sumaCorrecta ? "" : "   (int desbordado)") << endl;
+        cout << "  Producto escalar    Fraccion: " << setw(9) << tEscalar * 1e9 / e.longitud
+             << " ns/op   int: " << setw(9) << tEscalarInt * 1e9 / e.longitud << " ns/op"
+             << (escalarCorrecto ? "" : "   (int desbordado)") << endl;
+        cout << "  Suma exacta en forma " << (suma.getX().esGrande() ? "grande" : "compacta")
+             << ", x = " << setprecision(6) << suma.getX().aDecimal() << setprecision(1) << endl;
     }
-    
-    Vector3D operator*(int n) const {
-        return *this * Fraccion(n);
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// MCD por módulos, como lo hacía la versión original de Fraccion
+unsigned long long mcdEuclides(unsigned long long a, unsigned long long b) {
+    while (b != 0) {
+        unsigned long long temp = b;
+        b = a % b;
+        a = temp;
     }
-    
-    void imprimir(const string& etiqueta = "Vector") const {
-        cout << etiqueta << ": (" << x << ", " << y << ", " << z << ")" << endl;
+    return a;
+}
+
+// Compara la simplificación en cada operación con la acumulación perezosa
+// y el MCD de Euclides con el MCD binario
+void pruebaRendimientoNormalizacion() {
+    const int cantidad = 1000000;
+    mt19937_64 generador(7);
+
+    vector<unsigned long long> pares(2 * cantidad);
+    // Magnitudes típicas de numeradores y denominadores tras productos cruzados
+    for (unsigned long long& p : pares) p = (generador() >> 40) + 1;
+    unsigned long long control = 0;
+    double tEuclides = medirSegundos([&]() {
+        for (int i = 0; i < cantidad; i++) control += mcdEuclides(pares[2 * i], pares[2 * i + 1]);
+    });
+    double tBinario = medirSegundos([&]() {
+        for (int i = 0; i < cantidad; i++) control -= mcdBinario(pares[2 * i], pares[2 * i + 1]);
+    });
+
+    uniform_int_distribution<int> numeradores(-50, 50);
+    uniform_int_distribution<int> denominadores(1, 12);
+    vector<Vector3D> vectores;
+    vectores.reserve(cantidad);
+    for (int i = 0; i < cantidad; i++) {
+        int c[6];
+        for (int k = 0; k < 6; k += 2) {
+            c[k] = numeradores(generador);
+            c[k + 1] = denominadores(generador);
+        }
+        vectores.push_back(Vector3D(c[0], c[1], c[2], c[3], c[4], c[5]));
     }
-    
-    friend ostream& operator<<(ostream& os, const Vector3D& v) {
-        os << "(" << v.x << ", " << v.y << ", " << v.z << ")";
-        return os;
+
+    Fraccion escalarAnsioso, escalarPerezoso;
+    double tEscalarAnsioso = medirSegundos([&]() {
+        for (int i = 1; i < cantidad; i++) {
+            const Vector3D& a = vectores[i - 1];
+            const Vector3D& b = vectores[i];
+            Fraccion p = a.getX() * b.getX() + a.getY() * b.getY() + a.getZ() * b.getZ();
+            if (p == escalarAnsioso) escalarAnsioso = escalarAnsioso + Fraccion(1);
+        }
+    });
+    double tEscalarPerezoso = medirSegundos([&]() {
+        for (int i = 1; i < cantidad; i++) {
+            Fraccion p = vectores[i - 1] * vectores[i];
+            if (p == escalarPerezoso) escalarPerezoso = escalarPerezoso + Fraccion(1);
+        }
+    });
+
+    Vector3D sumaAnsiosa, sumaPerezosa;
+    double tSumaAnsiosa = medirSegundos([&]() {
+        for (const Vector3D& v : vectores) sumaAnsiosa = sumaAnsiosa + v;
+    });
+    double tSumaPerezosa = medirSegundos([&]() {
+        sumaPerezosa = Vector3D::sumarTodos(vectores);
+    });
+
+    cout << fixed << setprecision(1);
+    cout << "\n" << cantidad << " operaciones (millones de operaciones por segundo)" << endl;
+    cout << "  MCD 64 bits         Euclides: " << setw(7) << cantidad / tEuclides / 1e6
+         << "   binario: " << setw(7) << cantidad / tBinario / 1e6
+         << (control == 0 ? "" : "   (resultados distintos)") << endl;
+    cout << "  Producto escalar    ansioso:  " << setw(7) << cantidad / tEscalarAnsioso / 1e6
+         << "   perezoso: " << setw(6) << cantidad / tEscalarPerezoso / 1e6
+         << (escalarAnsioso == escalarPerezoso ? "" : "   (resultados distintos)") << endl;
+    cout << "  Suma de vectores    ansiosa:  " << setw(7) << cantidad / tSumaAnsiosa / 1e6
+         << "   perezosa: " << setw(6) << cantidad / tSumaPerezosa / 1e6
+         << (sumaAnsiosa.getX() == sumaPerezosa.getX() &&
+             sumaAnsiosa.getY() == sumaPerezosa.getY() &&
+             sumaAnsiosa.getZ() == sumaPerezosa.getZ() ? "" : "   (resultados distintos)") << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// Compara magnitud y normalización vector por vector con los núcleos SIMD del lote
+void pruebaRendimientoLote() {
+    const int cantidad = 2000000;
+    mt19937 generador(11);
+    uniform_int_distribution<int> numeradores(-100, 100);
+    uniform_int_distribution<int> denominadores(1, 16);
+    vector<Vector3D> vectores;
+    vectores.reserve(cantidad);
+    for (int i = 0; i < cantidad; i++) {
+        int c[6];
+        for (int k = 0; k < 6; k += 2) {
+            c[k] = numeradores(generador);
+            c[k + 1] = denominadores(generador);
+        }
+        vectores.push_back(Vector3D(c[0], c[1], c[2], c[3], c[4], c[5]));
     }
-    
-    friend Vector3D operator*(const Fraccion& f, const Vector3D& v) {
-        return v * f;
+
+    vector<double> magnitudesIndividuales(cantidad), normalizados(3 * cantidad);
+    double tIndividual = medirSegundos([&]() {
+        for (int i = 0; i < cantidad; i++) {
+            double m = vectores[i].magnitud();
+            magnitudesIndividuales[i] = m;
+            if (m != 0.0) {
+                normalizados[3 * i] = vectores[i].getX().aDecimal() / m;
+                normalizados[3 * i + 1] = vectores[i].getY().aDecimal() / m;
+                normalizados[3 * i + 2] = vectores[i].getZ().aDecimal() / m;
+            }
+        }
+    });
+
+    LoteVector3D lote;
+    double tConversion = medirSegundos([&]() { lote = LoteVector3D::desdeVectores(vectores); });
+    vector<double> magnitudesLote;
+    double tLote = medirSegundos([&]() {
+        lote.magnitudes(magnitudesLote);
+        lote.normalizar();
+    });
+
+    double errorMaximo = 0.0;
+    for (int i = 0; i < cantidad; i++)
+        errorMaximo = max(errorMaximo, fabs(magnitudesLote[i] - magnitudesIndividuales[i]));
+
+    cout << fixed << setprecision(2);
+    cout << "\n" << cantidad << " vectores, núcleos " << simd::nombreConjunto() << endl;
+    cout << "  Vector3D individual (magnitud + normalizar): " << setw(8) << tIndividual * 1e3 << " ms" << endl;
+    cout << "  Conversión a LoteVector3D:                   " << setw(8) << tConversion * 1e3 << " ms" << endl;
+    cout << "  LoteVector3D (magnitud + normalizar):        " << setw(8) << tLote * 1e3 << " ms" << endl;
+    cout << "  Diferencia máxima de magnitudes: " << scientific << errorMaximo << endl;
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Mide suma, producto escalar y magnitud sobre la misma nube de puntos
+// convertida al escalar T; la elección de T se resuelve en compilación
+template <typename T>
+void medirEscalar(const char* nombre, const vector<Vector3D>& origen) {
+    vector<Vector3DT<T>> vectores;
+    vectores.reserve(origen.size());
+    for (const Vector3D& v : origen)
+        vectores.push_back(Vector3DT<T>(RasgosEscalar<T>::desdeDecimal(v.getX().aDecimal(), 1000000),
+                                        RasgosEscalar<T>::desdeDecimal(v.getY().aDecimal(), 1000000),
+                                        RasgosEscalar<T>::desdeDecimal(v.getZ().aDecimal(), 1000000)));
+
+    Vector3DT<T> suma;
+    T escalar(0);
+    typename Vector3DT<T>::Real magnitudes = 0;
+    double tSuma = medirSegundos([&]() { suma = Vector3DT<T>::sumarTodos(vectores); });
+    double tEscalar = medirSegundos([&]() {
+        typename RasgosEscalar<T>::Acumulador acumulado;
+        for (size_t i = 1; i < vectores.size(); i++)
+            acumulado.sumar(vectores[i - 1] * vectores[i]);
+        escalar = acumulado.resultado();
+    });
+    double tMagnitud = medirSegundos([&]() {
+        for (const Vector3DT<T>& v : vectores) magnitudes += v.magnitud();
+    });
+
+    cout << "  " << setw(10) << left << nombre << right
+         << " suma: " << setw(8) << tSuma * 1e3 << " ms"
+         << "   escalar: " << setw(8) << tEscalar * 1e3 << " ms"
+         << "   magnitud: " << setw(8) << tMagnitud * 1e3 << " ms"
+         << "   (x = " << RasgosEscalar<T>::aReal(suma.getX()) << ")" << endl;
+    (void)escalar;
+    (void)magnitudes;
+}
+
+void pruebaRendimientoEscalares() {
+    const int cantidad = 1000000;
+    mt19937 generador(5);
+    uniform_int_distribution<int> numeradores(-64, 64);
+    uniform_int_distribution<int> exponentes(0, 3);
+    vector<Vector3D> vectores;
+    vectores.reserve(cantidad);
+    // Denominadores potencia de dos: exactos también en double y float
+    for (int i = 0; i < cantidad; i++)
+        vectores.push_back(Vector3D(numeradores(generador), 1 << exponentes(generador),
+                                    numeradores(generador), 1 << exponentes(generador),
+                                    numeradores(generador), 1 << exponentes(generador)));
+
+    cout << fixed << setprecision(2);
+    cout << "\n" << cantidad << " vectores por tipo de escalar" << endl;
+    medirEscalar<Fraccion>("Fraccion", vectores);
+    medirEscalar<double>("double", vectores);
+    medirEscalar<float>("float", vectores);
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// Compara la lectura original (string, find, substr, stoi) con LectorFracciones
+void pruebaRendimientoLectura() {
+    const int cantidad = 1000000;
+    mt19937 generador(3);
+    uniform_int_distribution<int> numeradores(-1000, 1000);
+    uniform_int_distribution<int> denominadores(1, 99);
+    string texto;
+    texto.reserve(cantidad * 3 * 8);
+    for (int i = 0; i < 3 * cantidad; i++) {
+        texto += to_string(numeradores(generador));
+        texto += '/';
+        texto += to_string(denominadores(generador));
+        texto += (i % 3 == 2) ? '\n' : ' ';
     }
-    
-    friend Vector3D operator*(int n, const Vector3D& v) {
-        return v * n;
+
+    // Suma de control barata para no medir la aritmética exacta
+    double sumaOriginal = 0.0, sumaLector = 0.0;
+    double tOriginal = medirSegundos([&]() {
+        istringstream entrada(texto);
+        string input;
+        while (entrada >> input) {
+            size_t pos = input.find('/');
+            int num = stoi(input.substr(0, pos));
+            int den = stoi(input.substr(pos + 1));
+            sumaOriginal += Fraccion(num, den).aDecimal();
+        }
+    });
+    double tLector = medirSegundos([&]() {
+        LectorFracciones lector(texto.data(), texto.size());
+        Vector3D v;
+        while (lector.siguienteVector(v)) {
+            sumaLector += v.getX().aDecimal() + v.getY().aDecimal() + v.getZ().aDecimal();
+        }
+    });
+
+    cout << fixed << setprecision(2);
+    cout << "\n" << cantidad << " vectores (" << texto.size() / 1e6 << " MB de texto)" << endl;
+    cout << "  string + stoi:      " << setw(8) << tOriginal * 1e3 << " ms   "
+         << setw(6) << cantidad / tOriginal / 1e6 << " M vectores/s" << endl;
+    cout << "  LectorFracciones:   " << setw(8) << tLector * 1e3 << " ms   "
+         << setw(6) << cantidad / tLector / 1e6 << " M vectores/s"
+         << (fabs(sumaOriginal - sumaLector) < 1e-6 * (1.0 + fabs(sumaOriginal)) ? "" : "   (resultados distintos)") << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// Escalamiento de la suma exacta y de la matriz de Gram de 1 a N hilos
+void pruebaRendimientoParalelo() {
+    const int cantidad = 2000000;
+    const int cantidadGram = 1500;
+    mt19937 generador(9);
+    uniform_int_distribution<int> numeradores(-100, 100);
+    uniform_int_distribution<int> denominadores(1, 12);
+    vector<Vector3D> vectores;
+    vectores.reserve(cantidad);
+    for (int i = 0; i < cantidad; i++) {
+        int c[6];
+        for (int k = 0; k < 6; k += 2) {
+            c[k] = numeradores(generador);
+            c[k + 1] = denominadores(generador);
+        }
+        vectores.push_back(Vector3D(c[0], c[1], c[2], c[3], c[4], c[5]));
     }
-};
+    vector<Vector3D> muestra(vectores.begin(), vectores.begin() + cantidadGram);
 
-//  FUNCIONES AUXILIARES 
+    unsigned maximo = max(1u, thread::hardware_concurrency());
+    vector<unsigned> configuraciones;
+    for (unsigned h = 1; h < maximo; h *= 2)
+        configuraciones.push_back(h);
+    configuraciones.push_back(maximo);
 
-// Función para leer una fracción desde el teclado
-Fraccion leerFraccion(const string& mensaje) {
-    string input;
-    cout << mensaje;
-    cin >> input;
-    
-    // Buscar la posición del '/'
-    size_t pos = input.find('/');
-    
-    if (pos != string::npos) {
-        // Es una fracción (ej: "2/3")
-        int num = stoi(input.substr(0, pos));
-        int den = stoi(input.substr(pos + 1));
-        return Fraccion(num, den);
-    } else {
-        // Es un entero (ej: "5")
-        int num = stoi(input);
-        return Fraccion(num, 1);
+    cout << fixed << setprecision(2);
+    cout << "\nSuma de " << cantidad << " vectores y matriz de Gram de "
+         << cantidadGram << "x" << cantidadGram << " (" << maximo << " nucleos)" << endl;
+    double tSumaBase = 0.0, tGramBase = 0.0;
+    Vector3D sumaBase;
+    for (unsigned h : configuraciones) {
+        GrupoHilos grupo(h);
+        Vector3D suma;
+        vector<Fraccion> gram;
+        double tSuma = medirSegundos([&]() { suma = sumaParalela(vectores, grupo); });
+        double tGram = medirSegundos([&]() { gram = matrizGram(muestra, grupo); });
+        if (h == 1) {
+            tSumaBase = tSuma;
+            tGramBase = tGram;
+            sumaBase = suma;
+        }
+        bool igual = suma.getX() == sumaBase.getX() && suma.getY() == sumaBase.getY() &&
+                     suma.getZ() == sumaBase.getZ();
+        cout << "  " << setw(3) << h << " hilos   suma: " << setw(8) << tSuma * 1e3 << " ms (x"
+             << setw(5) << tSumaBase / tSuma << ")   Gram: " << setw(8) << tGram * 1e3 << " ms (x"
+             << setw(5) << tGramBase / tGram << ")" << (igual ? "" : "   (suma distinta)") << endl;
     }
+    GrupoHilos todos;
+    cout << "  Centroide: " << centroideParalelo(vectores, todos) << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
 }
 
-// Función para leer un vector desde el teclado
-Vector3D leerVector(const string& mensaje) {
-    cout << mensaje << endl;
-    Fraccion x = leerFraccion("  Componente X (ej: 2/3 o 5): ");
-    Fraccion y = leerFraccion("  Componente Y (ej: 1/2 o -3): ");
-    Fraccion z = leerFraccion("  Componente Z (ej: -5/2 o 0): ");
-    return Vector3D(x, y, z);
+// Compara el árbol k-d con el recorrido lineal que usa magnitud() de diferencias
+void pruebaRendimientoArbolKD() {
+    const int cantidad = 200000;
+    const int consultas = 2000;
+    const size_t k = 8;
+    const double radio = 2.0;
+    mt19937 generador(21);
+    uniform_real_distribution<double> coordenada(-100.0, 100.0);
+    vector<Vector3DDoble> puntos;
+    puntos.reserve(cantidad);
+    for (int i = 0; i < cantidad; i++)
+        puntos.push_back(Vector3DDoble(coordenada(generador), coordenada(generador), coordenada(generador)));
+    LoteVector3D lote;
+    for (int i = 0; i < consultas; i++)
+        lote.agregar(coordenada(generador), coordenada(generador), coordenada(generador));
+
+    ArbolKD arbol;
+    double tConstruccion = medirSegundos([&]() { arbol = ArbolKD(puntos); });
+
+    vector<vector<Vecino>> lineales(consultas);
+    double tLineal = medirSegundos([&]() {
+        vector<Vecino> distancias(cantidad);
+        for (int q = 0; q < consultas; q++) {
+            Vector3DDoble consulta(lote.getX(q), lote.getY(q), lote.getZ(q));
+            for (int i = 0; i < cantidad; i++)
+                distancias[i] = Vecino{(size_t)i, (puntos[i] - consulta).magnitud()};
+            partial_sort(distancias.begin(), distancias.begin() + k, distancias.end(),
+                         [](const Vecino& a, const Vecino& b) { return a.distancia < b.distancia; });
+            lineales[q].assign(distancias.begin(), distancias.begin() + k);
+        }
+    });
+
+    GrupoHilos grupo;
+    vector<vector<Vecino>> cercanos, enRadio;
+    double tArbol = medirSegundos([&]() { cercanos = arbol.kCercanosLote(lote, k, grupo); });
+    double tRadio = medirSegundos([&]() { enRadio = arbol.enRadioLote(lote, radio, grupo); });
+
+    int distintos = 0;
+    size_t encontrados = 0;
+    for (int q = 0; q < consultas; q++) {
+        for (size_t j = 0; j < k; j++)
+            if (cercanos[q][j].distancia != lineales[q][j].distancia)
+                distintos++;
+        encontrados += enRadio[q].size();
+    }
+
+    cout << fixed << setprecision(2);
+    cout << "\n" << cantidad << " puntos, " << consultas << " consultas, k = " << k
+         << ", " << grupo.tamano() << " hilos" << endl;
+    cout << "  Construccion del arbol:   " << setw(9) << tConstruccion * 1e3 << " ms" << endl;
+    cout << "  k cercanos lineal:        " << setw(9) << tLineal * 1e3 << " ms" << endl;
+    cout << "  k cercanos arbol k-d:     " << setw(9) << tArbol * 1e3 << " ms   (x"
+         << tLineal / tArbol << ")" << (distintos == 0 ? "" : "   (resultados distintos)") << endl;
+    cout << "  Radio " << radio << " arbol k-d:      " << setw(9) << tRadio * 1e3 << " ms   ("
+         << encontrados << " puntos encontrados)" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// Transformación rígida 4x4 de una nube completa por cuadro
+void pruebaRendimientoTransformacion() {
+    const size_t cantidad = 10000000;
+    const size_t cantidadExacta = 200000;
+    mt19937 generador(17);
+    uniform_real_distribution<double> coordenada(-10.0, 10.0);
+
+    LoteVector3D lote(cantidad);
+    vector<Vector3DDoble> vectores(cantidad);
+    for (size_t i = 0; i < cantidad; i++) {
+        double x = coordenada(generador), y = coordenada(generador), z = coordenada(generador);
+        lote.datosX()[i] = x;
+        lote.datosY()[i] = y;
+        lote.datosZ()[i] = z;
+        vectores[i] = Vector3DDoble(x, y, z);
+    }
+
+    const double angulo = 0.01;
+    Transformacion4<double> movimiento = Transformacion4<double>::traslacion(0.1, -0.2, 0.05) *
+                                         Transformacion4<double>::rotacionZ(cos(angulo), sin(angulo)) *
+                                         Transformacion4<double>::rotacionX(cos(angulo), sin(angulo));
+
+    vector<Vector3DDoble> salida;
+    double tVectores = medirSegundos([&]() { movimiento.aplicar(vectores, salida); });
+    double tLote = medirSegundos([&]() { movimiento.aplicarEnSitio(lote); });
+
+    double diferencia = 0.0;
+    for (size_t i = 0; i < cantidad; i += 997)
+        diferencia = max(diferencia, fabs(lote.getX(i) - salida[i].getX()) +
+                                     fabs(lote.getY(i) - salida[i].getY()) +
+                                     fabs(lote.getZ(i) - salida[i].getZ()));
+
+    // Giro exacto (terna 3, 4, 5) sobre una nube con coordenadas racionales
+    vector<Vector3D> exactos, exactosSalida;
+    exactos.reserve(cantidadExacta);
+    uniform_int_distribution<int> numeradores(-50, 50);
+    uniform_int_distribution<int> denominadores(1, 8);
+    for (size_t i = 0; i < cantidadExacta; i++)
+        exactos.push_back(Vector3D(numeradores(generador), denominadores(generador),
+                                   numeradores(generador), denominadores(generador),
+                                   numeradores(generador), denominadores(generador)));
+    Transformacion4<Fraccion> exacta = Transformacion4<Fraccion>::traslacion(Fraccion(1, 2), 0, 0) *
+                                       Transformacion4<Fraccion>::rotacionZ(Fraccion(3, 5), Fraccion(4, 5));
+    double tExacta = medirSegundos([&]() { exacta.aplicar(exactos, exactosSalida); });
+
+    cout << fixed << setprecision(2);
+    cout << "\nTransformacion 4x4 de " << cantidad << " puntos, nucleos " << simd::nombreConjunto() << endl;
+    cout << "  vector<Vector3DDoble>:   " << setw(8) << tVectores * 1e3 << " ms   "
+         << setw(7) << cantidad / tVectores / 1e6 << " M puntos/s" << endl;
+    cout << "  LoteVector3D en sitio:   " << setw(8) << tLote * 1e3 << " ms   "
+         << setw(7) << cantidad / tLote / 1e6 << " M puntos/s" << endl;
+    cout << "  Diferencia maxima: " << scientific << diferencia << fixed << endl;
+    cout << "  Exacta con Fraccion (" << cantidadExacta << " puntos): " << setw(8) << tExacta * 1e3
+         << " ms   " << cantidadExacta / tExacta / 1e6 << " M puntos/s" << endl;
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Compara la salida con ofstream y endl (descarga en cada línea) contra
+// SalidaEnBloque, escribiendo al dispositivo nulo para medir solo el formato
+void pruebaRendimientoSalida() {
+    const size_t cantidad = 1000000;
+#ifdef _WIN32
+    const char* nulo = "NUL";
+#else
+    const char* nulo = "/dev/null";
+#endif
+    mt19937 generador(23);
+    uniform_int_distribution<int> numeradores(-100000, 100000);
+    uniform_int_distribution<int> denominadores(1, 999);
+    vector<Vector3D> vectores;
+    vectores.reserve(cantidad);
+    for (size_t i = 0; i < cantidad; i++)
+        vectores.push_back(Vector3D(numeradores(generador), denominadores(generador),
+                                    numeradores(generador), denominadores(generador),
+                                    numeradores(generador), denominadores(generador)));
+
+    double tEndl = medirSegundos([&]() {
+        ofstream archivo(nulo);
+        for (const Vector3D& v : vectores)
+            archivo << v << endl;
+    });
+    double tSaltos = medirSegundos([&]() {
+        ofstream archivo(nulo);
+        for (const Vector3D& v : vectores)
+            archivo << v << '\n';
+    });
+    double tBloque = medirSegundos([&]() {
+        FILE* archivo = fopen(nulo, "wb");
+        if (archivo == nullptr)
+            return;
+        {
+            SalidaEnBloque salida(archivo);
+            for (const Vector3D& v : vectores)
+                salida << v << '\n';
+        }
+        fclose(archivo);
+    });
+
+    // Comprobación: ambos formatos producen el mismo texto
+    ostringstream esperado;
+    char texto[3 * Fraccion::MAX_CARACTERES + 8];
+    size_t distintos = 0;
+    for (size_t i = 0; i < cantidad; i += 1009) {
+        esperado.str("");
+        esperado << vectores[i];
+        char* fin = escribirValor(texto, texto + sizeof(texto), vectores[i]);
+        if (fin == nullptr || esperado.str() != string(texto, fin))
+            distintos++;
+    }
+
+    cout << fixed << setprecision(2);
+    cout << "\nEscritura de " << cantidad << " vectores en " << nulo << endl;
+    cout << "  ofstream << v << endl:   " << setw(8) << tEndl * 1e3 << " ms" << endl;
+    cout << "  ofstream << v << '\\n':  " << setw(8) << tSaltos * 1e3 << " ms" << endl;
+    cout << "  SalidaEnBloque:          " << setw(8) << tBloque * 1e3 << " ms   ("
+         << tEndl / tBloque << "x)" << endl;
+    cout << "  Diferencias de formato: " << distintos << endl;
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+void menuRendimiento() {
+    int opcion;
+    cout << " PRUEBAS DE RENDIMIENTO " << endl;
+    cout << "1. Fraccion (compacta/grande) vs int de 32 bits" << endl;
+    cout << "2. Simplificacion ansiosa vs perezosa (MCD binario)" << endl;
+    cout << "3. Vector3D individual vs LoteVector3D (SIMD)" << endl;
+    cout << "4. Vector3DT: Fraccion vs double vs float" << endl;
+    cout << "5. Lectura de fracciones: string/stoi vs from_chars" << endl;
+    cout << "6. Reducciones exactas en paralelo (1 a N hilos)" << endl;
+    cout << "7. Arbol k-d vs busqueda lineal" << endl;
+    cout << "8. Transformacion rigida de una nube de puntos" << endl;
+    cout << "9. Salida: ofstream con endl vs SalidaEnBloque" << endl;
+    cout << "0. Volver" << endl;
+    cout << "Seleccione una opcion: ";
+    cin >> opcion;
+
+    switch (opcion) {
+        case 1:
+            pruebaRendimientoFraccion();
+            break;
+        case 2:
+            pruebaRendimientoNormalizacion();
+            break;
+        case 3:
+            pruebaRendimientoLote();
+            break;
+        case 4:
+            pruebaRendimientoEscalares();
+            break;
+        case 5:
+            pruebaRendimientoLectura();
+            break;
+        case 6:
+            pruebaRendimientoParalelo();
+            break;
+        case 7:
+            pruebaRendimientoArbolKD();
+            break;
+        case 8:
+            pruebaRendimientoTransformacion();
+            break;
+        case 9:
+            pruebaRendimientoSalida();
+            break;
+        case 0:
+            break;
+        default:
+            cout << "Opcion invalida." << endl;
+    }
 }
 
 //  PROGRAMA PRINCIPAL 
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--flujo")
+        return ejecutarFlujo(argc, argv);
+
     int opcion;
     
     do {
@@ -230,6 +2758,7 @@ int main() {
         cout << "4. Restar dos vectores" << endl;
         cout << "5. Producto escalar de dos vectores" << endl;
         cout << "6. Multiplicar vector por escalar" << endl;
+        cout << "7. Pruebas de rendimiento" << endl;
         cout << "0. Salir" << endl;
         cout << "NOTA: Ingrese fracciones como 2/3 o enteros como 5" << endl;
         cout << "Seleccione una opcion: ";
@@ -305,6 +2834,10 @@ int main() {
                 break;
             }
             
+            case 7: {
+                menuRendimiento();
+                break;
+            }
             
             case 0:
                 cout << "chaooo" << endl;
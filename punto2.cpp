@@ -6,111 +6,3486 @@
 #include <locale>
 #include <vector>
 #include <string>
+#include <cstring>
+#include <new>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstddef>
+#include <array>
+#include <optional>
+#include <sstream>
+#include <fstream>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <deque>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
-//  CLASE MATRIZ
-// Representa una matriz de tamaño filas×columnas con memoria dinámica.
-// Permite operaciones como transpuesta, multiplicación y acceso directo.
-class Matriz {
+//  CLASE GRUPO HILOS
+// Hilos persistentes que reparten un conjunto de tareas numeradas 0..total-1.
+// Cada participante recibe un tramo contiguo; al terminar el suyo roba
+// tareas de los tramos de los demás, así un hilo lento no retrasa al resto.
+// El hilo que llama a paraCada también trabaja. No admite llamadas anidadas.
+// La tarea se pasa como puntero más función de llamada (sin std::function),
+// así repartir trabajo no reserva memoria.
+class GrupoHilos {
 private:
-    int filas;               // Número de filas
-    int columnas;            // Número de columnas
-    double** datos;          // Puntero doble para almacenar la matriz
-    string nombre;           // Nombre de la matriz (A, B, M1, etc.)
+    struct alignas(64) Tramo {
+        atomic<long long> siguiente{0};
+        long long fin = 0;
+    };
 
-    // Reserva memoria dinámica
-    void reservarMemoria() {
-        datos = new double*[filas];
-        for (int i = 0; i < filas; i++)
-            datos[i] = new double[columnas];
+    int participantes;
+    vector<thread> hilos;
+    unique_ptr<Tramo[]> tramos;
+    mutex candado;
+    condition_variable hayTrabajo, terminado;
+    const void* contexto = nullptr;
+    void (*llamar)(const void*, long long) = nullptr;
+    long long generacion = 0;
+    int activos = 0;
+    bool salir = false;
+
+    void vaciarTramo(int t) {
+        long long i;
+        while ((i = tramos[t].siguiente.fetch_add(1)) < tramos[t].fin)
+            llamar(contexto, i);
     }
 
-    // Libera la memoria dinámica
-    void liberarMemoria() {
-        if (datos != nullptr) {
+    // Primero el tramo propio y luego los ajenos, empezando por el vecino
+    void trabajar(int id) {
+        for (int d = 0; d < participantes; d++)
+            vaciarTramo((id + d) % participantes);
+    }
+
+    void bucle(int id) {
+        long long vista = 0;
+        while (true) {
+            unique_lock<mutex> bloqueo(candado);
+            hayTrabajo.wait(bloqueo, [&]() { return salir || generacion != vista; });
+            if (salir)
+                return;
+            vista = generacion;
+            bloqueo.unlock();
+            trabajar(id);
+            bloqueo.lock();
+            if (--activos == 0)
+                terminado.notify_one();
+        }
+    }
+
+public:
+    // total: número de participantes contando al hilo que llama
+    explicit GrupoHilos(int total)
+        : participantes(max(1, total)), tramos(new Tramo[max(1, total)]) {
+        for (int id = 1; id < participantes; id++)
+            hilos.emplace_back(&GrupoHilos::bucle, this, id);
+    }
+
+    ~GrupoHilos() {
+        {
+            lock_guard<mutex> bloqueo(candado);
+            salir = true;
+        }
+        hayTrabajo.notify_all();
+        for (thread& h : hilos)
+            h.join();
+    }
+
+    GrupoHilos(const GrupoHilos&) = delete;
+    GrupoHilos& operator=(const GrupoHilos&) = delete;
+
+    int tamano() const { return participantes; }
+
+    // Ejecuta f(i) para cada i en [0, total) y espera a que terminen todas
+    template <typename Funcion>
+    void paraCada(long long total, const Funcion& f) {
+        {
+            lock_guard<mutex> bloqueo(candado);
+            contexto = &f;
+            llamar = [](const void* c, long long i) { (*static_cast<const Funcion*>(c))(i); };
+            for (int t = 0; t < participantes; t++) {
+                tramos[t].siguiente = total * t / participantes;
+                tramos[t].fin = total * (t + 1) / participantes;
+            }
+            activos = participantes - 1;
+            generacion++;
+        }
+        hayTrabajo.notify_all();
+        trabajar(0);
+        unique_lock<mutex> bloqueo(candado);
+        terminado.wait(bloqueo, [&]() { return activos == 0; });
+    }
+};
+
+//  CLASE VISTA MATRIZ
+// Referencia de solo lectura a los elementos de una matriz, sin copiarlos.
+// El elemento (i, j) está en datos[i * pasoFila + j * pasoColumna]: la
+// transpuesta intercambia dimensiones y pasos, y una submatriz con saltos
+// desplaza el origen y multiplica los pasos. La matriz de origen debe seguir
+// viva (y con el mismo tamaño) mientras se use la vista.
+class VistaMatriz {
+private:
+    const double* datos;
+    int filas;
+    int columnas;
+    ptrdiff_t pasoFila;
+    ptrdiff_t pasoColumna;
+    const string* nombreOrigen;   // Nombre de la matriz de origen (puede ser nullptr)
+    bool transpuesta;
+    bool parcial;
+
+public:
+    VistaMatriz()
+        : datos(nullptr), filas(0), columnas(0), pasoFila(0), pasoColumna(0),
+          nombreOrigen(nullptr), transpuesta(false), parcial(false) {}
+
+    VistaMatriz(const double* datos, int filas, int columnas, ptrdiff_t pasoFila,
+                ptrdiff_t pasoColumna, const string* nombreOrigen = nullptr)
+        : datos(datos), filas(filas), columnas(columnas), pasoFila(pasoFila),
+          pasoColumna(pasoColumna), nombreOrigen(nombreOrigen), transpuesta(false), parcial(false) {}
+
+    // Métodos de acceso
+    int getFilas() const { return filas; }
+    int getColumnas() const { return columnas; }
+    ptrdiff_t getPasoFila() const { return pasoFila; }
+    ptrdiff_t getPasoColumna() const { return pasoColumna; }
+    const double* getDatos() const { return datos; }
+
+    string getNombre() const {
+        string nombre = nombreOrigen ? *nombreOrigen : "V";
+        if (parcial) nombre += "[]";
+        if (transpuesta) nombre += "^T";
+        return nombre;
+    }
+
+    double operator()(int i, int j) const {
+        return datos[i * pasoFila + j * pasoColumna];
+    }
+
+    double getValor(int i, int j) const {
+        if (i >= 0 && i < filas && j >= 0 && j < columnas)
+            return (*this)(i, j);
+        cerr << "Error: Índices fuera de rango.\n";
+        return 0.0;
+    }
+
+    VistaMatriz transpuestaVista() const {
+        VistaMatriz t(datos, columnas, filas, pasoColumna, pasoFila, nombreOrigen);
+        t.transpuesta = !transpuesta;
+        t.parcial = parcial;
+        return t;
+    }
+
+    // Bloque de filas×columnas desde (fila0, columna0), tomando una de cada
+    // saltoFilas filas y una de cada saltoColumnas columnas
+    VistaMatriz submatriz(int fila0, int columna0, int numFilas, int numColumnas,
+                          int saltoFilas = 1, int saltoColumnas = 1) const {
+        if (fila0 < 0 || columna0 < 0 || numFilas < 0 || numColumnas < 0 ||
+            saltoFilas < 1 || saltoColumnas < 1 ||
+            (numFilas > 0 && fila0 + (long long)(numFilas - 1) * saltoFilas >= filas) ||
+            (numColumnas > 0 && columna0 + (long long)(numColumnas - 1) * saltoColumnas >= columnas)) {
+            cerr << "Error: Submatriz fuera de rango.\n";
+            numFilas = numColumnas = 0;
+            fila0 = columna0 = 0;
+        }
+        VistaMatriz sub(datos + fila0 * pasoFila + columna0 * pasoColumna, numFilas, numColumnas,
+                        pasoFila * saltoFilas, pasoColumna * saltoColumnas, nombreOrigen);
+        sub.transpuesta = transpuesta;
+        sub.parcial = true;
+        return sub;
+    }
+
+    VistaMatriz rangoFilas(int fila0, int numFilas) const {
+        return submatriz(fila0, 0, numFilas, columnas);
+    }
+
+    VistaMatriz rangoColumnas(int columna0, int numColumnas) const {
+        return submatriz(0, columna0, filas, numColumnas);
+    }
+
+    // Imprime los elementos de la vista
+    void imprimir(int precision = 2) const {
+        cout << "Matriz " << getNombre() << " (" << filas << "x" << columnas << "):\n";
+        for (int i = 0; i < filas; i++) {
+            cout << "[ ";
+            for (int j = 0; j < columnas; j++) {
+                cout << setw(8) << fixed << setprecision(precision) << (*this)(i, j);
+                if (j < columnas - 1) cout << ", ";
+            }
+            cout << " ]\n";
+        }
+        cout << endl;
+    }
+};
+
+// Copia un bloque m×n con pasos arbitrarios a un destino por filas. Divide
+// siempre la dimensión mayor hasta llegar a bloques de HOJA×HOJA, de modo que
+// en cada nivel de la caché acaba habiendo un bloque de origen y uno de
+// destino que caben en él, sin depender de su tamaño (cache-oblivious).
+// Es lo que hace rápida a la transpuesta materializada.
+inline void copiarRecursivo(int m, int n, const double* origen, ptrdiff_t pasoFila,
+                            ptrdiff_t pasoColumna, double* destino, ptrdiff_t pasoDestino) {
+    const int HOJA = 16;
+    if (m <= HOJA && n <= HOJA) {
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < n; j++)
+                destino[i * pasoDestino + j] = origen[i * pasoFila + j * pasoColumna];
+    } else if (m >= n) {
+        int mitad = m / 2;
+        copiarRecursivo(mitad, n, origen, pasoFila, pasoColumna, destino, pasoDestino);
+        copiarRecursivo(m - mitad, n, origen + mitad * pasoFila, pasoFila, pasoColumna,
+                        destino + mitad * pasoDestino, pasoDestino);
+    } else {
+        int mitad = n / 2;
+        copiarRecursivo(m, mitad, origen, pasoFila, pasoColumna, destino, pasoDestino);
+        copiarRecursivo(m, n - mitad, origen + mitad * pasoColumna, pasoFila, pasoColumna,
+                        destino + mitad, pasoDestino);
+    }
+}
+
+//  NUCLEO DE MULTIPLICACION (GEMM)
+// C += A * B sobre arreglos por filas con paso, en bloques que caben en
+// caché: se empaqueta un panel KC×NC de B (para L3/L2) y un bloque MC×KC
+// de A (para L2), y un micro-núcleo MR×NR acumula en registros.
+namespace gemm {
+
+const int MR = 6;        // Filas del micro-núcleo
+const int NR = 8;        // Columnas del micro-núcleo (dos registros AVX)
+const int MC = 96;       // Filas de A por bloque empaquetado
+const int KC = 256;      // Profundidad de los paneles
+const int NC = 2048;     // Columnas de B por panel empaquetado
+
+// Por debajo de este volumen (m*n*k) no compensa empaquetar
+const long long UMBRAL_BLOQUES = 48LL * 48 * 48;
+
+inline const char* nombreNucleo() {
+#if defined(__AVX2__) && defined(__FMA__)
+    return "AVX2/FMA 6x8";
+#elif defined(__SSE2__)
+    return "SSE2 6x8";
+#else
+    return "portable 6x8";
+#endif
+}
+
+// Copia un bloque mc×kc de A en tiras de MR filas: para cada p, MR valores
+// consecutivos. Las filas que faltan en la última tira quedan en cero.
+// Los pasos arbitrarios permiten empaquetar directamente vistas transpuestas,
+// y el factor alfa se aplica aquí, sin una pasada extra sobre el resultado.
+inline void empaquetarA(int mc, int kc, const double* a, ptrdiff_t pasoFila,
+                        ptrdiff_t pasoColumna, double alfa, double* destino) {
+    for (int ir = 0; ir < mc; ir += MR) {
+        int filas = min(MR, mc - ir);
+        for (int p = 0; p < kc; p++) {
             for (int i = 0; i < filas; i++)
-                delete[] datos[i];
-            delete[] datos;
-            datos = nullptr;
+                destino[i] = alfa * a[(ir + i) * pasoFila + p * pasoColumna];
+            for (int i = filas; i < MR; i++)
+                destino[i] = 0.0;
+            destino += MR;
+        }
+    }
+}
+
+// Copia un panel kc×nc de B en tiras de NR columnas: para cada p, NR valores
+inline void empaquetarB(int kc, int nc, const double* b, ptrdiff_t pasoFila,
+                        ptrdiff_t pasoColumna, double* destino) {
+    for (int jr = 0; jr < nc; jr += NR) {
+        int columnas = min(NR, nc - jr);
+        for (int p = 0; p < kc; p++) {
+            const double* fila = b + p * pasoFila + jr * pasoColumna;
+            if (pasoColumna == 1)
+                for (int j = 0; j < columnas; j++)
+                    destino[j] = fila[j];
+            else
+                for (int j = 0; j < columnas; j++)
+                    destino[j] = fila[j * pasoColumna];
+            for (int j = columnas; j < NR; j++)
+                destino[j] = 0.0;
+            destino += NR;
+        }
+    }
+}
+
+// Micro-núcleo: acumula en "bloque" (MR×NR, por filas) el producto de una
+// tira de A por una tira de B, ambas empaquetadas
+inline void microNucleo(int kc, const double* a, const double* b, double* bloque) {
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+    __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+    __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+    for (int p = 0; p < kc; p++) {
+        __m256d b0 = _mm256_loadu_pd(b);
+        __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d ai = _mm256_broadcast_sd(a);
+        c00 = _mm256_fmadd_pd(ai, b0, c00); c01 = _mm256_fmadd_pd(ai, b1, c01);
+        ai = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(ai, b0, c10); c11 = _mm256_fmadd_pd(ai, b1, c11);
+        ai = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(ai, b0, c20); c21 = _mm256_fmadd_pd(ai, b1, c21);
+        ai = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(ai, b0, c30); c31 = _mm256_fmadd_pd(ai, b1, c31);
+        ai = _mm256_broadcast_sd(a + 4);
+        c40 = _mm256_fmadd_pd(ai, b0, c40); c41 = _mm256_fmadd_pd(ai, b1, c41);
+        ai = _mm256_broadcast_sd(a + 5);
+        c50 = _mm256_fmadd_pd(ai, b0, c50); c51 = _mm256_fmadd_pd(ai, b1, c51);
+        a += MR;
+        b += NR;
+    }
+    _mm256_storeu_pd(bloque + 0 * NR, c00); _mm256_storeu_pd(bloque + 0 * NR + 4, c01);
+    _mm256_storeu_pd(bloque + 1 * NR, c10); _mm256_storeu_pd(bloque + 1 * NR + 4, c11);
+    _mm256_storeu_pd(bloque + 2 * NR, c20); _mm256_storeu_pd(bloque + 2 * NR + 4, c21);
+    _mm256_storeu_pd(bloque + 3 * NR, c30); _mm256_storeu_pd(bloque + 3 * NR + 4, c31);
+    _mm256_storeu_pd(bloque + 4 * NR, c40); _mm256_storeu_pd(bloque + 4 * NR + 4, c41);
+    _mm256_storeu_pd(bloque + 5 * NR, c50); _mm256_storeu_pd(bloque + 5 * NR + 4, c51);
+#elif defined(__SSE2__)
+    // Con 16 registros de 2 elementos el bloque 6x8 no cabe: se calcula en
+    // dos mitades de 6x4 que releen la misma tira de A desde L1
+    for (int mitad = 0; mitad < NR; mitad += 4) {
+        __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+        __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+        __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+        __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+        __m128d c40 = _mm_setzero_pd(), c41 = _mm_setzero_pd();
+        __m128d c50 = _mm_setzero_pd(), c51 = _mm_setzero_pd();
+        const double* pa = a;
+        const double* pb = b + mitad;
+        for (int p = 0; p < kc; p++) {
+            __m128d b0 = _mm_loadu_pd(pb);
+            __m128d b1 = _mm_loadu_pd(pb + 2);
+            __m128d ai = _mm_set1_pd(pa[0]);
+            c00 = _mm_add_pd(c00, _mm_mul_pd(ai, b0)); c01 = _mm_add_pd(c01, _mm_mul_pd(ai, b1));
+            ai = _mm_set1_pd(pa[1]);
+            c10 = _mm_add_pd(c10, _mm_mul_pd(ai, b0)); c11 = _mm_add_pd(c11, _mm_mul_pd(ai, b1));
+            ai = _mm_set1_pd(pa[2]);
+            c20 = _mm_add_pd(c20, _mm_mul_pd(ai, b0)); c21 = _mm_add_pd(c21, _mm_mul_pd(ai, b1));
+            ai = _mm_set1_pd(pa[3]);
+            c30 = _mm_add_pd(c30, _mm_mul_pd(ai, b0)); c31 = _mm_add_pd(c31, _mm_mul_pd(ai, b1));
+            ai = _mm_set1_pd(pa[4]);
+            c40 = _mm_add_pd(c40, _mm_mul_pd(ai, b0)); c41 = _mm_add_pd(c41, _mm_mul_pd(ai, b1));
+            ai = _mm_set1_pd(pa[5]);
+            c50 = _mm_add_pd(c50, _mm_mul_pd(ai, b0)); c51 = _mm_add_pd(c51, _mm_mul_pd(ai, b1));
+            pa += MR;
+            pb += NR;
+        }
+        double* destino = bloque + mitad;
+        _mm_storeu_pd(destino + 0 * NR, c00); _mm_storeu_pd(destino + 0 * NR + 2, c01);
+        _mm_storeu_pd(destino + 1 * NR, c10); _mm_storeu_pd(destino + 1 * NR + 2, c11);
+        _mm_storeu_pd(destino + 2 * NR, c20); _mm_storeu_pd(destino + 2 * NR + 2, c21);
+        _mm_storeu_pd(destino + 3 * NR, c30); _mm_storeu_pd(destino + 3 * NR + 2, c31);
+        _mm_storeu_pd(destino + 4 * NR, c40); _mm_storeu_pd(destino + 4 * NR + 2, c41);
+        _mm_storeu_pd(destino + 5 * NR, c50); _mm_storeu_pd(destino + 5 * NR + 2, c51);
+    }
+#else
+    // Versión portable: el compilador vectoriza el bucle interno de NR
+    double acumulado[MR][NR] = {};
+    for (int p = 0; p < kc; p++) {
+        for (int i = 0; i < MR; i++)
+            for (int j = 0; j < NR; j++)
+                acumulado[i][j] += a[i] * b[j];
+        a += MR;
+        b += NR;
+    }
+    for (int i = 0; i < MR; i++)
+        for (int j = 0; j < NR; j++)
+            bloque[i * NR + j] = acumulado[i][j];
+#endif
+}
+
+// Suma el bloque calculado a C, recortado a las filas y columnas válidas
+inline void sumarBloque(const double* bloque, int filas, int columnas, double* c, int pasoC) {
+    for (int i = 0; i < filas; i++)
+        for (int j = 0; j < columnas; j++)
+            c[(size_t)i * pasoC + j] += bloque[i * NR + j];
+}
+
+// Bucle i-k-j sin empaquetar, para productos pequeños
+inline void multiplicarDirecto(int m, int n, int k, const VistaMatriz& a,
+                               const VistaMatriz& b, double* c, int pasoC, double alfa = 1.0) {
+    ptrdiff_t pasoColumnaB = b.getPasoColumna();
+    for (int i = 0; i < m; i++) {
+        double* filaC = c + (size_t)i * pasoC;
+        for (int p = 0; p < k; p++) {
+            double aip = alfa * a(i, p);
+            const double* filaB = b.getDatos() + p * b.getPasoFila();
+            if (pasoColumnaB == 1)
+                for (int j = 0; j < n; j++)
+                    filaC[j] += aip * filaB[j];
+            else
+                for (int j = 0; j < n; j++)
+                    filaC[j] += aip * filaB[j * pasoColumnaB];
+        }
+    }
+}
+
+// C (m×n) += alfa * A (m×k) * B (k×n), siempre por bloques empaquetados.
+// Solo se usan los datos y pasos de las vistas; las dimensiones son m, n y k.
+inline void multiplicarBloques(int m, int n, int k, const VistaMatriz& a,
+                               const VistaMatriz& b, double* c, int pasoC, double alfa = 1.0) {
+    const double* datosA = a.getDatos();
+    const double* datosB = b.getDatos();
+    ptrdiff_t filaA = a.getPasoFila(), columnaA = a.getPasoColumna();
+    ptrdiff_t filaB = b.getPasoFila(), columnaB = b.getPasoColumna();
+
+    // Los paneles empaquetados se reutilizan entre llamadas del mismo hilo
+    static thread_local vector<double> panelA, panelB;
+    panelA.resize((size_t)MC * KC);
+    panelB.resize((size_t)KC * ((NC + NR - 1) / NR * NR));
+    double bloque[MR * NR];
+
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = min(NC, n - jc);
+        for (int pc = 0; pc < k; pc += KC) {
+            int kc = min(KC, k - pc);
+            empaquetarB(kc, nc, datosB + pc * filaB + jc * columnaB, filaB, columnaB,
+                        panelB.data());
+            for (int ic = 0; ic < m; ic += MC) {
+                int mc = min(MC, m - ic);
+                empaquetarA(mc, kc, datosA + ic * filaA + pc * columnaA, filaA, columnaA, alfa,
+                            panelA.data());
+                for (int jr = 0; jr < nc; jr += NR) {
+                    const double* tiraB = panelB.data() + (size_t)jr * kc;
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        microNucleo(kc, panelA.data() + (size_t)ir * kc, tiraB, bloque);
+                        sumarBloque(bloque, min(MR, mc - ir), min(NR, nc - jr),
+                                    c + (size_t)(ic + ir) * pasoC + jc + jr, pasoC);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// C += alfa * A * B con A (m×k) y B (k×n) dados como vistas
+inline void multiplicar(const VistaMatriz& a, const VistaMatriz& b, double* c, int pasoC,
+                        double alfa = 1.0) {
+    int m = a.getFilas(), n = b.getColumnas(), k = a.getColumnas();
+    if ((long long)m * n * k <= UMBRAL_BLOQUES)
+        multiplicarDirecto(m, n, k, a, b, c, pasoC, alfa);
+    else
+        multiplicarBloques(m, n, k, a, b, c, pasoC, alfa);
+}
+
+// C (m×n) += A (m×k) * B (k×n), por filas con paso
+inline void multiplicar(int m, int n, int k, const double* a, int pasoA,
+                        const double* b, int pasoB, double* c, int pasoC) {
+    multiplicar(VistaMatriz(a, m, k, pasoA, 1), VistaMatriz(b, k, n, pasoB, 1), c, pasoC);
+}
+
+// Número de hilos de la multiplicación; por defecto, los de la máquina
+inline int& hilosConfigurados() {
+    static int hilos = max(1u, thread::hardware_concurrency());
+    return hilos;
+}
+
+inline void setHilos(int hilos) { hilosConfigurados() = max(1, hilos); }
+inline int getHilos() { return hilosConfigurados(); }
+
+// Memoria de los paneles empaquetados que conserva cada hilo (incluido el
+// que llama) después de su primer producto por bloques
+inline size_t bytesPaneles() {
+    size_t porHilo = (size_t)MC * KC + (size_t)KC * ((NC + NR - 1) / NR * NR);
+    return getHilos() * porHilo * sizeof(double);
+}
+
+// Grupo compartido; se vuelve a crear si cambia el número de hilos
+inline GrupoHilos& grupo() {
+    static unique_ptr<GrupoHilos> compartido;
+    if (!compartido || compartido->tamano() != getHilos())
+        compartido.reset(new GrupoHilos(getHilos()));
+    return *compartido;
+}
+
+const int TM = 192;                                // Filas de C por tesela
+const int TN = 256;                                // Columnas de C por tesela
+const long long UMBRAL_PARALELO = 192LL * 192 * 192;
+
+// C += A * B repartiendo teselas TM×TN de C entre los hilos. Cada tesela es
+// independiente (cada hilo empaqueta sus propios paneles) y se suma en el
+// mismo orden que en serie, así que el resultado es idéntico.
+inline void multiplicarParalelo(const VistaMatriz& a, const VistaMatriz& b, double* c, int pasoC,
+                                double alfa = 1.0) {
+    int m = a.getFilas(), n = b.getColumnas(), k = a.getColumnas();
+    long long filasTeselas = (m + TM - 1) / TM;
+    long long columnasTeselas = (n + TN - 1) / TN;
+    if (getHilos() <= 1 || (long long)m * n * k < UMBRAL_PARALELO ||
+        filasTeselas * columnasTeselas < 2) {
+        multiplicar(a, b, c, pasoC, alfa);
+        return;
+    }
+
+    grupo().paraCada(filasTeselas * columnasTeselas, [&](long long t) {
+        int i0 = (int)(t / columnasTeselas) * TM;
+        int j0 = (int)(t % columnasTeselas) * TN;
+        multiplicarBloques(min(TM, m - i0), min(TN, n - j0), k, a.rangoFilas(i0, min(TM, m - i0)),
+                           b.rangoColumnas(j0, min(TN, n - j0)), c + (size_t)i0 * pasoC + j0, pasoC,
+                           alfa);
+    });
+}
+
+inline void multiplicarParalelo(int m, int n, int k, const double* a, int pasoA,
+                                const double* b, int pasoB, double* c, int pasoC) {
+    multiplicarParalelo(VistaMatriz(a, m, k, pasoA, 1), VistaMatriz(b, k, n, pasoB, 1), c, pasoC);
+}
+
+//  Strassen-Winograd
+// Producto con 7 multiplicaciones y 15 sumas de bloques por nivel, en lugar
+// de 8 multiplicaciones. Recurre hasta que alguna dimensión es menor o igual
+// que el corte y ahí usa el producto por bloques. Las dimensiones impares se
+// resuelven pelando la última fila/columna y corrigiéndolas con productos
+// clásicos. Los temporales de todos los niveles salen de un único arreglo.
+
+const int CORTE_STRASSEN = 512;
+
+// c = a + signo * b, sobre bloques m×n con paso
+inline void combinar(int m, int n, const double* a, int pasoA, const double* b, int pasoB,
+                     double signo, double* c, int pasoC) {
+    for (int i = 0; i < m; i++) {
+        const double* filaA = a + (size_t)i * pasoA;
+        const double* filaB = b + (size_t)i * pasoB;
+        double* filaC = c + (size_t)i * pasoC;
+        for (int j = 0; j < n; j++)
+            filaC[j] = filaA[j] + signo * filaB[j];
+    }
+}
+
+inline void anular(int m, int n, double* c, int pasoC) {
+    for (int i = 0; i < m; i++)
+        fill(c + (size_t)i * pasoC, c + (size_t)i * pasoC + n, 0.0);
+}
+
+// Elementos de espacio temporal que necesita la recursión completa
+inline size_t espacioStrassen(int m, int n, int k, int corte) {
+    if (min(m, min(n, k)) <= corte)
+        return 0;
+    int mh = m / 2, nh = n / 2, kh = k / 2;
+    return (size_t)mh * kh + (size_t)kh * nh + (size_t)mh * nh +
+           espacioStrassen(mh, nh, kh, corte);
+}
+
+// C = A * B. Cada nivel usa X (mh×kh), Y (kh×nh) y Z (mh×nh) del espacio y
+// los cuadrantes de C como almacenamiento de los productos intermedios.
+inline void strassen(int m, int n, int k, const double* a, int pasoA, const double* b, int pasoB,
+                     double* c, int pasoC, int corte, double* espacio) {
+    if (min(m, min(n, k)) <= corte) {
+        anular(m, n, c, pasoC);
+        multiplicarParalelo(m, n, k, a, pasoA, b, pasoB, c, pasoC);
+        return;
+    }
+
+    int mh = m / 2, nh = n / 2, kh = k / 2;
+    const double* a11 = a;
+    const double* a12 = a + kh;
+    const double* a21 = a + (size_t)mh * pasoA;
+    const double* a22 = a21 + kh;
+    const double* b11 = b;
+    const double* b12 = b + nh;
+    const double* b21 = b + (size_t)kh * pasoB;
+    const double* b22 = b21 + nh;
+    double* c11 = c;
+    double* c12 = c + nh;
+    double* c21 = c + (size_t)mh * pasoC;
+    double* c22 = c21 + nh;
+    double* x = espacio;
+    double* y = x + (size_t)mh * kh;
+    double* z = y + (size_t)kh * nh;
+    double* resto = z + (size_t)mh * nh;
+
+    combinar(mh, kh, a11, pasoA, a21, pasoA, -1.0, x, kh);             // S3 = A11 - A21
+    combinar(kh, nh, b22, pasoB, b12, pasoB, -1.0, y, nh);             // T3 = B22 - B12
+    strassen(mh, nh, kh, x, kh, y, nh, c21, pasoC, corte, resto);      // P7 = S3 T3
+    combinar(mh, kh, a21, pasoA, a22, pasoA, 1.0, x, kh);              // S1 = A21 + A22
+    combinar(kh, nh, b12, pasoB, b11, pasoB, -1.0, y, nh);             // T1 = B12 - B11
+    strassen(mh, nh, kh, x, kh, y, nh, c22, pasoC, corte, resto);      // P5 = S1 T1
+    combinar(mh, kh, x, kh, a11, pasoA, -1.0, x, kh);                  // S2 = S1 - A11
+    combinar(kh, nh, b22, pasoB, y, nh, -1.0, y, nh);                  // T2 = B22 - T1
+    strassen(mh, nh, kh, x, kh, y, nh, c12, pasoC, corte, resto);      // P6 = S2 T2
+    combinar(mh, kh, a12, pasoA, x, kh, -1.0, x, kh);                  // S4 = A12 - S2
+    strassen(mh, nh, kh, x, kh, b22, pasoB, c11, pasoC, corte, resto); // P3 = S4 B22
+    strassen(mh, nh, kh, a11, pasoA, b11, pasoB, z, nh, corte, resto); // P1 = A11 B11
+    combinar(mh, nh, c12, pasoC, z, nh, 1.0, c12, pasoC);              // U2 = P1 + P6
+    combinar(mh, nh, c21, pasoC, c12, pasoC, 1.0, c21, pasoC);         // U3 = U2 + P7
+    combinar(mh, nh, c12, pasoC, c22, pasoC, 1.0, c12, pasoC);         // U4 = U2 + P5
+    combinar(mh, nh, c12, pasoC, c11, pasoC, 1.0, c12, pasoC);         // C12 = U4 + P3
+    combinar(mh, nh, c21, pasoC, c22, pasoC, 1.0, c22, pasoC);         // C22 = U3 + P5
+    combinar(kh, nh, y, nh, b21, pasoB, -1.0, y, nh);                  // T4 = T2 - B21
+    strassen(mh, nh, kh, a22, pasoA, y, nh, c11, pasoC, corte, resto); // P4 = A22 T4
+    combinar(mh, nh, c21, pasoC, c11, pasoC, -1.0, c21, pasoC);        // C21 = U3 - P4
+    strassen(mh, nh, kh, a12, pasoA, b21, pasoB, c11, pasoC, corte, resto); // P2 = A12 B21
+    combinar(mh, nh, c11, pasoC, z, nh, 1.0, c11, pasoC);              // C11 = P1 + P2
+
+    // Pelado de dimensiones impares
+    int m2 = 2 * mh, n2 = 2 * nh, k2 = 2 * kh;
+    if (k2 < k)
+        multiplicar(m2, n2, 1, a + k2, pasoA, b + (size_t)k2 * pasoB, pasoB, c, pasoC);
+    if (n2 < n) {
+        anular(m2, 1, c + n2, pasoC);
+        multiplicar(m2, 1, k, a, pasoA, b + n2, pasoB, c + n2, pasoC);
+    }
+    if (m2 < m) {
+        double* ultimaFila = c + (size_t)m2 * pasoC;
+        anular(1, n, ultimaFila, pasoC);
+        multiplicar(1, n, k, a + (size_t)m2 * pasoA, pasoA, b, pasoB, ultimaFila, pasoC);
+    }
+}
+
+// C = A * B con Strassen-Winograd; el espacio temporal se conserva entre llamadas
+inline void multiplicarStrassen(int m, int n, int k, const double* a, int pasoA,
+                                const double* b, int pasoB, double* c, int pasoC,
+                                int corte = CORTE_STRASSEN) {
+    static thread_local vector<double> arena;
+    corte = max(corte, 1);
+    size_t necesario = espacioStrassen(m, n, k, corte);
+    if (arena.size() < necesario)
+        arena.resize(necesario);
+    strassen(m, n, k, a, pasoA, b, pasoB, c, pasoC, corte, arena.data());
+}
+
+} // namespace gemm
+
+class Matriz;
+
+//  EXPRESIONES DE PRODUCTO
+// A * B * C ... no calcula nada: devuelve una ExpresionProducto<N> con vistas
+// de los N factores y el producto de todos los escalares que aparezcan. Al
+// asignarla a una Matriz:
+//  - el orden de los productos se elige con el algoritmo de la cadena de
+//    matrices (programación dinámica sobre las dimensiones), sin importar
+//    los paréntesis escritos;
+//  - el escalar se aplica una sola vez, al empaquetar el último producto;
+//  - las transpuestas y submatrices son vistas y se empaquetan sin copiarse;
+//  - el resultado se escribe directamente en la matriz destino si ya tiene
+//    el tamaño correcto y no es uno de los factores; solo los productos
+//    intermedios usan temporales, y se liberan en cuanto se consumen.
+// Las matrices de los factores deben seguir vivas hasta la asignación, así
+// que la expresión no debe guardarse en una variable (auto).
+template <size_t N>
+class ExpresionProducto {
+private:
+    array<VistaMatriz, N> factores;
+    double escalar;
+
+    // corte[i][j] = k: el producto de los factores i..j se parte en (i..k)(k+1..j)
+    struct Plan {
+        int corte[N][N];
+        double costo;
+    };
+
+    double dimension(size_t i) const {
+        return i == 0 ? factores[0].getFilas() : factores[i - 1].getColumnas();
+    }
+
+    Plan planificar() const {
+        Plan plan;
+        double costo[N][N];
+        for (size_t i = 0; i < N; i++) {
+            costo[i][i] = 0.0;
+            plan.corte[i][i] = (int)i;
+        }
+        for (size_t longitud = 2; longitud <= N; longitud++) {
+            for (size_t i = 0; i + longitud <= N; i++) {
+                size_t j = i + longitud - 1;
+                costo[i][j] = numeric_limits<double>::infinity();
+                for (size_t k = i; k < j; k++) {
+                    double c = costo[i][k] + costo[k + 1][j] +
+                               dimension(i) * dimension(k + 1) * dimension(j + 1);
+                    if (c < costo[i][j]) {
+                        costo[i][j] = c;
+                        plan.corte[i][j] = (int)k;
+                    }
+                }
+            }
         }
+        plan.costo = costo[0][N - 1];
+        return plan;
+    }
+
+    void evaluarRango(const Plan& plan, int i, int j, double alfa, double* c, int pasoC) const;
+
+    string parentesisRango(const Plan& plan, int i, int j) const {
+        if (i == j)
+            return factores[i].getNombre();
+        int k = plan.corte[i][j];
+        return "(" + parentesisRango(plan, i, k) + "×" + parentesisRango(plan, k + 1, j) + ")";
     }
 
 public:
-    // Constructor que inicializa la matriz con valores aleatorios
-    Matriz(int filas, int columnas, double min, double max, string nombre = "M")
-        : filas(filas), columnas(columnas), datos(nullptr), nombre(nombre) {
+    ExpresionProducto(const array<VistaMatriz, N>& factores, double escalar)
+        : factores(factores), escalar(escalar) {}
 
-        if (filas <= 0 || columnas <= 0) {
-            cerr << "Error: El tamaño de la matriz debe ser positivo.\n";
-            this->filas = 1;
-            this->columnas = 1;
+    const array<VistaMatriz, N>& getFactores() const { return factores; }
+    double getEscalar() const { return escalar; }
+    int getFilas() const { return factores[0].getFilas(); }
+    int getColumnas() const { return factores[N - 1].getColumnas(); }
+
+    bool esValida() const {
+        for (size_t i = 0; i + 1 < N; i++)
+            if (factores[i].getColumnas() != factores[i + 1].getFilas())
+                return false;
+        return true;
+    }
+
+    string getNombre() const {
+        string nombre;
+        if (escalar != 1.0) {
+            ostringstream texto;
+            texto << escalar << "×";
+            nombre = texto.str();
+        }
+        for (size_t i = 0; i < N; i++) {
+            if (i > 0) nombre += "×";
+            nombre += factores[i].getNombre();
+        }
+        return nombre;
+    }
+
+    // (A B ... Z)^T = Z^T ... B^T A^T, sin copiar nada
+    ExpresionProducto<N> transpuestaVista() const {
+        array<VistaMatriz, N> invertidos;
+        for (size_t i = 0; i < N; i++)
+            invertidos[i] = factores[N - 1 - i].transpuestaVista();
+        return ExpresionProducto<N>(invertidos, escalar);
+    }
+
+    // Multiplicaciones escalares del orden elegido y del orden de izquierda a derecha
+    double costoOptimo() const { return esValida() ? planificar().costo : 0.0; }
+
+    double costoIzquierdaDerecha() const {
+        double costo = 0.0;
+        for (size_t i = 1; i < N; i++)
+            costo += dimension(0) * dimension(i) * dimension(i + 1);
+        return costo;
+    }
+
+    // Orden elegido, por ejemplo "((A×B)×C)"
+    string parentesis() const {
+        if (!esValida())
+            return "Error";
+        return parentesisRango(planificar(), 0, N - 1);
+    }
+
+    // Escribe el resultado en destino (ver la descripción de la clase)
+    void evaluarEn(Matriz& destino) const;
+};
+
+template <size_t N, size_t M>
+array<VistaMatriz, N + M> concatenarFactores(const array<VistaMatriz, N>& a,
+                                             const array<VistaMatriz, M>& b) {
+    array<VistaMatriz, N + M> todos;
+    for (size_t i = 0; i < N; i++) todos[i] = a[i];
+    for (size_t i = 0; i < M; i++) todos[N + i] = b[i];
+    return todos;
+}
+
+// Operadores que construyen expresiones; el producto se calcula al asignar
+inline ExpresionProducto<2> operator*(const VistaMatriz& a, const VistaMatriz& b) {
+    return ExpresionProducto<2>({a, b}, 1.0);
+}
+
+inline ExpresionProducto<1> operator*(double escalar, const VistaMatriz& a) {
+    return ExpresionProducto<1>({a}, escalar);
+}
+
+inline ExpresionProducto<1> operator*(const VistaMatriz& a, double escalar) {
+    return ExpresionProducto<1>({a}, escalar);
+}
+
+template <size_t N>
+ExpresionProducto<N + 1> operator*(const ExpresionProducto<N>& e, const VistaMatriz& b) {
+    return ExpresionProducto<N + 1>(concatenarFactores(e.getFactores(), array<VistaMatriz, 1>{b}),
+                                    e.getEscalar());
+}
+
+template <size_t N>
+ExpresionProducto<N + 1> operator*(const VistaMatriz& a, const ExpresionProducto<N>& e) {
+    return ExpresionProducto<N + 1>(concatenarFactores(array<VistaMatriz, 1>{a}, e.getFactores()),
+                                    e.getEscalar());
+}
+
+template <size_t N, size_t M>
+ExpresionProducto<N + M> operator*(const ExpresionProducto<N>& a, const ExpresionProducto<M>& b) {
+    return ExpresionProducto<N + M>(concatenarFactores(a.getFactores(), b.getFactores()),
+                                    a.getEscalar() * b.getEscalar());
+}
+
+template <size_t N>
+ExpresionProducto<N> operator*(double escalar, const ExpresionProducto<N>& e) {
+    return ExpresionProducto<N>(e.getFactores(), escalar * e.getEscalar());
+}
+
+template <size_t N>
+ExpresionProducto<N> operator*(const ExpresionProducto<N>& e, double escalar) {
+    return ExpresionProducto<N>(e.getFactores(), e.getEscalar() * escalar);
+}
+
+//  NUMEROS ALEATORIOS
+// Generador por contador: el elemento k (k = i * columnas + j) de una
+// matriz llenada con la semilla s vale f(s, k), donde f es SplitMix64 (la
+// posición k de su secuencia, que pasa BigCrush). Como cada valor depende
+// solo de su índice, las filas se reparten entre hilos sin estado
+// compartido y el resultado es el mismo con cualquier número de hilos.
+namespace aleatorio {
+
+const uint64_t INCREMENTO = 0x9E3779B97F4A7C15ULL;   // Parte fraccionaria de la razón áurea
+const long long UMBRAL_PARALELO = 1LL << 16;         // Elementos a partir de los cuales se reparte
+const double PI = 3.14159265358979323846;            // M_PI no es estándar (falta con -std=c++17 en MinGW)
+
+inline uint64_t mezclar(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Uniforme en [0, 1) con 53 bits de mantisa
+inline double uniforme(uint64_t base, uint64_t k) {
+    return (double)(mezclar(base + (k + 1) * INCREMENTO) >> 11) * 0x1.0p-53;
+}
+
+// Con AVX2 o AVX-512 los uniformes se generan por lotes: un bucle aplica
+// mezclar a los contadores y otro los convierte, ambos de longitud fija y
+// sin dependencias, así que el compilador los vectoriza. SSE2 no tiene
+// multiplicación de 64 bits en vectores y ahí se genera uno por uno.
+#if defined(__AVX2__)
+const int LOTE = 16;
+
+// (double) de un entero de menos de 2^53 sin la conversión de 64 bits, que
+// solo existe en vectores con AVX-512: cada mitad de 32 bits se pone en la
+// mantisa de 2^52 y se le resta 2^52. El resultado es exacto.
+inline double aDouble53(uint64_t v) {
+    uint64_t alto = (v >> 32) | 0x4330000000000000ULL, bajo = (v & 0xFFFFFFFFULL) | 0x4330000000000000ULL;
+    double a, b;
+    memcpy(&a, &alto, sizeof(a));
+    memcpy(&b, &bajo, sizeof(b));
+    return (a - 0x1.0p52) * 0x1.0p32 + (b - 0x1.0p52);
+}
+#else
+const int LOTE = 1;
+
+inline double aDouble53(uint64_t v) { return (double)v; }
+#endif
+
+// destino[t] = f(uniforme(base, k + t)) para t en [0, LOTE), con los mismos
+// valores que uniforme(). f se aplica en el bucle de la conversión (y debe
+// capturar por valor para que vectorice).
+template <typename Funcion>
+inline void uniformesLote(uint64_t base, uint64_t k, double* destino, const Funcion& f) {
+    uint64_t bits[LOTE];
+    for (int t = 0; t < LOTE; t++)
+        bits[t] = mezclar(base + (k + t + 1) * INCREMENTO) >> 11;
+    for (int t = 0; t < LOTE; t++)
+        destino[t] = f(aDouble53(bits[t]) * 0x1.0p-53);
+}
+
+struct Distribucion {
+    enum Tipo { UNIFORME, NORMAL, ENTERA };
+    Tipo tipo;
+    double a, b;    // [min, max) | media y desviación | [min, max] enteros
+
+    static Distribucion uniformeEntre(double min, double max) { return {UNIFORME, min, max}; }
+    static Distribucion normal(double media, double desviacion) { return {NORMAL, media, desviacion}; }
+    static Distribucion entera(long long min, long long max) { return {ENTERA, (double)min, (double)max}; }
+};
+
+// Semilla para las matrices que no indican una: cada una toma la siguiente
+inline atomic<uint64_t>& semillaGlobal() {
+    static atomic<uint64_t> semilla{0};
+    return semilla;
+}
+
+inline void sembrar(uint64_t semilla) { semillaGlobal() = semilla; }
+inline uint64_t siguienteSemilla() { return semillaGlobal().fetch_add(1); }
+
+// Llena filas x columnas elementos (paso entre filas) con la distribución
+inline void llenar(double* datos, int filas, int columnas, int paso, const Distribucion& d,
+                   uint64_t semilla) {
+    uint64_t base = mezclar(semilla);
+    double minimo = d.a, ancho = d.b - d.a, cantidad = d.b - d.a + 1.0;
+    double media = d.a, desviacion = d.b;
+    auto llenarFilas = [&](int inicio, int fin) {
+        for (int i = inicio; i < fin; i++) {
+            double* fila = datos + (size_t)i * paso;
+            uint64_t k0 = (uint64_t)i * columnas;
+            int j = 0;
+            if (d.tipo == Distribucion::UNIFORME) {
+                auto escalar = [minimo, ancho](double u) { return minimo + ancho * u; };
+                for (; j + LOTE <= columnas; j += LOTE)
+                    uniformesLote(base, k0 + j, fila + j, escalar);
+                for (; j < columnas; j++)
+                    fila[j] = escalar(uniforme(base, k0 + j));
+            } else if (d.tipo == Distribucion::ENTERA) {
+                // floor no vectoriza: los uniformes salen por lotes y el
+                // redondeo se hace después, elemento a elemento
+                auto escalar = [cantidad](double u) { return u * cantidad; };
+                for (; j + LOTE <= columnas; j += LOTE)
+                    uniformesLote(base, k0 + j, fila + j, escalar);
+                for (; j < columnas; j++)
+                    fila[j] = escalar(uniforme(base, k0 + j));
+                for (j = 0; j < columnas; j++)
+                    fila[j] = minimo + floor(fila[j]);
+            } else {
+                // Box-Muller: los índices 2p y 2p + 1 reciben el coseno y el
+                // seno del par p, aunque queden en filas distintas. Los
+                // uniformes salen por lotes; log, cos y sin son escalares.
+                auto transformar = [&](double u1, double u2, double& coseno, double& seno) {
+                    double radio = desviacion * sqrt(-2.0 * log(1.0 - u1));
+                    double angulo = 2.0 * PI * u2;
+                    coseno = media + radio * cos(angulo);
+                    seno = media + radio * sin(angulo);
+                };
+                auto par = [&](uint64_t p, double& coseno, double& seno) {
+                    transformar(uniforme(base, 2 * p), uniforme(base, 2 * p + 1), coseno, seno);
+                };
+                double sobrante;
+                if (k0 % 2 == 1)
+                    par(k0 / 2, sobrante, fila[j++]);
+                if (LOTE > 1)
+                    for (; j + LOTE <= columnas; j += LOTE) {
+                        uniformesLote(base, k0 + j, fila + j, [](double u) { return u; });
+                        for (int t = 0; t < LOTE; t += 2)
+                            transformar(fila[j + t], fila[j + t + 1], fila[j + t], fila[j + t + 1]);
+                    }
+                for (; j + 1 < columnas; j += 2)
+                    par((k0 + j) / 2, fila[j], fila[j + 1]);
+                if (j < columnas)
+                    par((k0 + j) / 2, fila[j], sobrante);
+            }
+        }
+    };
+
+    const int FILAS_POR_TAREA = 64;
+    long long tareas = (filas + FILAS_POR_TAREA - 1) / FILAS_POR_TAREA;
+    if (gemm::getHilos() <= 1 || (long long)filas * columnas < UMBRAL_PARALELO || tareas < 2) {
+        llenarFilas(0, filas);
+        return;
+    }
+    gemm::grupo().paraCada(tareas, [&](long long t) {
+        int inicio = (int)t * FILAS_POR_TAREA;
+        llenarFilas(inicio, min(filas, inicio + FILAS_POR_TAREA));
+    });
+}
+
+} // namespace aleatorio
+
+//  POOL DE MEMORIA PARA MATRICES
+// Los bloques de las matrices se piden por clases de tamaño: cada potencia
+// de dos se divide en cuatro clases (como mucho un 25 % de relleno), y un
+// bloque liberado queda en la lista de su clase para la siguiente matriz
+// de tamaño parecido en lugar de volver al sistema. Así una sesión que
+// crea y borra cientos de matrices reutiliza siempre los mismos bloques y
+// no fragmenta el heap. Las listas retienen como mucho limiteLibres bytes.
+class PoolMatrices {
+public:
+    struct Estadisticas {
+        long long solicitudes = 0;       // Bloques pedidos
+        long long reutilizados = 0;      // Servidos desde una lista libre
+        long long reservasSistema = 0;   // Pedidos al sistema
+        long long liberadosSistema = 0;  // Devueltos al sistema
+        size_t bytesPedidos = 0;         // En uso, según lo pedido
+        size_t bytesEnUso = 0;           // En uso, según la clase
+        size_t bytesLibres = 0;          // Retenidos en las listas
+        size_t picoBytes = 0;            // Máximo de bytesEnUso + bytesLibres
+    };
+
+private:
+    static constexpr size_t ALINEACION = 64;
+    map<size_t, vector<void*>> libres;   // Clase (bytes) -> bloques libres
+    Estadisticas estadisticas;
+    size_t limiteLibres = (size_t)256 << 20;
+    bool habilitado = true;
+    mutable mutex cerrojo;
+
+    void* pedirAlSistema(size_t bytes) {
+        estadisticas.reservasSistema++;
+        return ::operator new(bytes, align_val_t(ALINEACION));
+    }
+
+    void devolverAlSistema(void* p) {
+        estadisticas.liberadosSistema++;
+        ::operator delete(p, align_val_t(ALINEACION));
+    }
+
+public:
+    ~PoolMatrices() { vaciar(); }
+
+    static PoolMatrices& global() {
+        static PoolMatrices pool;
+        return pool;
+    }
+
+    // Tamaño de la clase de "bytes": múltiplo de 2^(e-2) con 2^e < bytes <= 2^(e+1)
+    static size_t tamanoClase(size_t bytes) {
+        if (bytes <= ALINEACION)
+            return ALINEACION;
+        int e = 0;
+        while (((size_t)2 << e) < bytes)
+            e++;
+        size_t salto = max(ALINEACION, ((size_t)1 << e) / 4);
+        return (bytes + salto - 1) / salto * salto;
+    }
+
+    void* reservar(size_t bytes) {
+        size_t clase = tamanoClase(bytes);
+        lock_guard<mutex> guardia(cerrojo);
+        estadisticas.solicitudes++;
+        estadisticas.bytesPedidos += bytes;
+        estadisticas.bytesEnUso += clase;
+
+        void* p;
+        auto lista = libres.find(clase);
+        if (lista != libres.end() && !lista->second.empty()) {
+            p = lista->second.back();
+            lista->second.pop_back();
+            estadisticas.reutilizados++;
+            estadisticas.bytesLibres -= clase;
+        } else {
+            p = pedirAlSistema(clase);
+        }
+        estadisticas.picoBytes = max(estadisticas.picoBytes, estadisticas.bytesEnUso + estadisticas.bytesLibres);
+        return p;
+    }
+
+    // "bytes" debe ser el mismo tamaño con que se reservó el bloque
+    void liberar(void* p, size_t bytes) {
+        size_t clase = tamanoClase(bytes);
+        lock_guard<mutex> guardia(cerrojo);
+        estadisticas.bytesPedidos -= bytes;
+        estadisticas.bytesEnUso -= clase;
+        if (habilitado && estadisticas.bytesLibres + clase <= limiteLibres) {
+            libres[clase].push_back(p);
+            estadisticas.bytesLibres += clase;
+        } else {
+            devolverAlSistema(p);
         }
+    }
+
+    // Devuelve al sistema todos los bloques libres
+    void vaciar() {
+        lock_guard<mutex> guardia(cerrojo);
+        for (auto& [clase, lista] : libres)
+            for (void* p : lista)
+                devolverAlSistema(p);
+        libres.clear();
+        estadisticas.bytesLibres = 0;
+    }
+
+    // Sin pool cada bloque liberado vuelve al sistema (para comparar)
+    void setHabilitado(bool valor) {
+        vaciar();
+        lock_guard<mutex> guardia(cerrojo);
+        habilitado = valor;
+    }
+
+    void setLimiteLibres(size_t bytes) {
+        lock_guard<mutex> guardia(cerrojo);
+        limiteLibres = bytes;
+    }
+
+    Estadisticas getEstadisticas() const {
+        lock_guard<mutex> guardia(cerrojo);
+        return estadisticas;
+    }
+
+    void reiniciarEstadisticas() {
+        lock_guard<mutex> guardia(cerrojo);
+        Estadisticas nuevas;
+        nuevas.bytesPedidos = estadisticas.bytesPedidos;
+        nuevas.bytesEnUso = estadisticas.bytesEnUso;
+        nuevas.bytesLibres = estadisticas.bytesLibres;
+        nuevas.picoBytes = estadisticas.bytesEnUso + estadisticas.bytesLibres;
+        estadisticas = nuevas;
+    }
+
+    void imprimirEstadisticas() const {
+        Estadisticas e = getEstadisticas();
+        // En KB o MB según la magnitud, para que una sesión pequeña no salga en cero
+        auto memoria = [](size_t bytes) {
+            ostringstream texto;
+            texto << fixed << setprecision(2);
+            if (bytes < 1024 * 1024)
+                texto << bytes / 1024.0 << " KB";
+            else
+                texto << bytes / (1024.0 * 1024.0) << " MB";
+            return texto.str();
+        };
+        cout << fixed << setprecision(2);
+        cout << "Bloques pedidos: " << e.solicitudes << " (" << e.reutilizados << " reutilizados, "
+             << e.reservasSistema << " nuevos del sistema, " << e.liberadosSistema << " devueltos)\n";
+        cout << "En uso: " << memoria(e.bytesEnUso) << " (" << memoria(e.bytesPedidos)
+             << " pedidos; relleno de clase "
+             << (e.bytesEnUso ? 100.0 * (e.bytesEnUso - e.bytesPedidos) / e.bytesEnUso : 0.0) << " %)\n";
+        cout << "Libres retenidos: " << memoria(e.bytesLibres) << " ("
+             << (e.bytesEnUso + e.bytesLibres ? 100.0 * e.bytesLibres / (e.bytesEnUso + e.bytesLibres) : 0.0)
+             << " % de lo reservado), pico " << memoria(e.picoBytes) << "\n";
+        cout.unsetf(ios::floatfield);
+        cout << setprecision(6);
+    }
+};
+
+//  CLASE MATRIZ
+// Representa una matriz de tamaño filas×columnas con memoria dinámica.
+// Permite operaciones como transpuesta, multiplicación y acceso directo.
+// Los elementos se guardan por filas en un solo bloque contiguo alineado;
+// cada fila ocupa "paso" elementos (columnas redondeado a la línea de caché).
+class Matriz {
+public:
+    static const size_t ALINEACION = 64;                          // Bytes (línea de caché)
+    static const int ELEMENTOS_LINEA = ALINEACION / sizeof(double);
+
+    // Contadores globales de reservas, para las pruebas de rendimiento
+    static inline long long reservas = 0;
+    static inline long long bytesReservados = 0;
+
+private:
+    int filas;               // Número de filas
+    int columnas;            // Número de columnas
+    int paso;                // Elementos entre el inicio de dos filas
+    double* datos;           // Bloque contiguo de filas*paso elementos
+    string nombre;           // Nombre de la matriz (A, B, M1, etc.)
+
+    // Reserva un solo bloque alineado (del pool) y pone en cero el relleno de cada fila
+    void reservarMemoria() {
+        paso = (columnas + ELEMENTOS_LINEA - 1) / ELEMENTOS_LINEA * ELEMENTOS_LINEA;
+        size_t bytes = (size_t)filas * paso * sizeof(double);
+        datos = static_cast<double*>(PoolMatrices::global().reservar(bytes));
+        reservas++;
+        bytesReservados += bytes;
+        if (paso > columnas)
+            for (int i = 0; i < filas; i++)
+                memset(datos + (size_t)i * paso + columnas, 0, (paso - columnas) * sizeof(double));
+    }
+
+    // Libera la memoria dinámica
+    void liberarMemoria() {
+        if (datos != nullptr) {
+            PoolMatrices::global().liberar(datos, (size_t)filas * paso * sizeof(double));
+            datos = nullptr;
+        }
+    }
+
+public:
+    // Constructor que inicializa la matriz con valores aleatorios uniformes
+    // en [min, max), con la siguiente semilla global (ver aleatorio::sembrar)
+    Matriz(int filas, int columnas, double min, double max, string nombre = "M")
+        : Matriz(filas, columnas, aleatorio::Distribucion::uniformeEntre(min, max),
+                 aleatorio::siguienteSemilla(), nombre) {}
+
+    // Constructor con una distribución y semilla explícitas: la misma semilla
+    // da la misma matriz con cualquier número de hilos
+    Matriz(int filas, int columnas, const aleatorio::Distribucion& distribucion, uint64_t semilla,
+           string nombre = "M")
+        : filas(filas), columnas(columnas), datos(nullptr), nombre(nombre) {
+
+        if (filas <= 0 || columnas <= 0) {
+            cerr << "Error: El tamaño de la matriz debe ser positivo.\n";
+            this->filas = 1;
+            this->columnas = 1;
+        }
+
+        reservarMemoria();
+        llenarAleatorio(distribucion, semilla);
+    }
+
+    // Constructor que permite ingresar valores manualmente
+    Matriz(int filas, int columnas, string nombre = "M")
+        : filas(filas), columnas(columnas), datos(nullptr), nombre(nombre) {
+
+        if (filas <= 0 || columnas <= 0) {
+            cerr << "Error: El tamaño de la matriz debe ser positivo.\n";
+            this->filas = 1;
+            this->columnas = 1;
+        }
+
+        reservarMemoria();
+
+        cout << "\nIngrese los elementos de la matriz " << nombre 
+             << " (" << filas << "x" << columnas << "):\n";
+        for (int i = 0; i < filas; i++) {
+            for (int j = 0; j < columnas; j++) {
+                cout << "  Elemento [" << i << "][" << j << "]: ";
+                cin >> fila(i)[j];
+            }
+        }
+    }
+
+    // Materializa una vista (transpuesta, submatriz...) en una matriz nueva
+    explicit Matriz(const VistaMatriz& vista)
+        : filas(vista.getFilas()), columnas(vista.getColumnas()), datos(nullptr),
+          nombre(vista.getNombre()) {
+        reservarMemoria();
+        if (vista.getPasoColumna() == 1) {
+            for (int i = 0; i < filas; i++)
+                memcpy(fila(i), vista.getDatos() + i * vista.getPasoFila(), columnas * sizeof(double));
+        } else {
+            copiarRecursivo(filas, columnas, vista.getDatos(), vista.getPasoFila(),
+                            vista.getPasoColumna(), datos, paso);
+        }
+    }
+
+    // Evalúa un producto perezoso (ver ExpresionProducto)
+    template <size_t N>
+    Matriz(const ExpresionProducto<N>& expresion)
+        : filas(0), columnas(0), paso(0), datos(nullptr) {
+        expresion.evaluarEn(*this);
+    }
+
+    // Constructor de copia: una sola reserva y una sola copia del bloque
+    Matriz(const Matriz& otra)
+        : filas(otra.filas), columnas(otra.columnas), datos(nullptr), nombre(otra.nombre) {
+        reservarMemoria();
+        if (otra.datos != nullptr)
+            memcpy(datos, otra.datos, (size_t)filas * paso * sizeof(double));
+    }
+
+    // Constructor de movimiento: toma el bloque de la otra sin reservar
+    Matriz(Matriz&& otra) noexcept
+        : filas(otra.filas), columnas(otra.columnas), paso(otra.paso), datos(otra.datos),
+          nombre(move(otra.nombre)) {
+        otra.filas = otra.columnas = otra.paso = 0;
+        otra.datos = nullptr;
+    }
+
+    // Constructor para matriz vacía o inicializada en ceros
+    Matriz(int filas, int columnas, bool inicializar, string nombre)
+        : filas(filas), columnas(columnas), datos(nullptr), nombre(nombre) {
+        reservarMemoria();
+        if (inicializar)
+            memset(datos, 0, (size_t)filas * paso * sizeof(double));
+    }
+
+    // Destructor
+    ~Matriz() {
+        liberarMemoria();
+    }
+
+    // Operador de asignación; reutiliza el bloque si el tamaño coincide
+    Matriz& operator=(const Matriz& otra) {
+        if (this != &otra) {
+            if (filas != otra.filas || columnas != otra.columnas || datos == nullptr) {
+                liberarMemoria();
+                filas = otra.filas;
+                columnas = otra.columnas;
+                reservarMemoria();
+            }
+            nombre = otra.nombre;
+            if (otra.datos != nullptr)
+                memcpy(datos, otra.datos, (size_t)filas * paso * sizeof(double));
+        }
+        return *this;
+    }
+
+    // Asignación por movimiento
+    Matriz& operator=(Matriz&& otra) noexcept {
+        if (this != &otra) {
+            liberarMemoria();
+            filas = otra.filas;
+            columnas = otra.columnas;
+            paso = otra.paso;
+            datos = otra.datos;
+            nombre = move(otra.nombre);
+            otra.filas = otra.columnas = otra.paso = 0;
+            otra.datos = nullptr;
+        }
+        return *this;
+    }
+
+    // Asigna un producto perezoso; reutiliza el bloque si el tamaño coincide
+    template <size_t N>
+    Matriz& operator=(const ExpresionProducto<N>& expresion) {
+        expresion.evaluarEn(*this);
+        return *this;
+    }
+
+    // Acceso sin comprobación a la fila i (uso interno de los núcleos)
+    double* fila(int i) { return datos + (size_t)i * paso; }
+    const double* fila(int i) const { return datos + (size_t)i * paso; }
+
+    // Métodos de acceso
+    int getFilas() const { return filas; }
+    int getColumnas() const { return columnas; }
+    int getPaso() const { return paso; }
+    double* getDatos() { return datos; }
+    const double* getDatos() const { return datos; }
+    string getNombre() const { return nombre; }
+    void setNombre(string nuevoNombre) { nombre = nuevoNombre; }
+
+    // Operador [] para acceso por fila
+    double* operator[](int i) {
+        if (i < 0 || i >= filas) {
+            cerr << "Error: Índice fuera de rango.\n";
+            return fila(0);
+        }
+        return fila(i);
+    }
+
+    const double* operator[](int i) const {
+        if (i < 0 || i >= filas) {
+            cerr << "Error: Índice fuera de rango.\n";
+            return fila(0);
+        }
+        return fila(i);
+    }
+
+    // Vistas sin copia sobre esta matriz
+    VistaMatriz vista() const { return VistaMatriz(datos, filas, columnas, paso, 1, &nombre); }
+    operator VistaMatriz() const { return vista(); }
+    VistaMatriz vistaTranspuesta() const { return vista().transpuestaVista(); }
+    VistaMatriz submatriz(int fila0, int columna0, int numFilas, int numColumnas,
+                          int saltoFilas = 1, int saltoColumnas = 1) const {
+        return vista().submatriz(fila0, columna0, numFilas, numColumnas, saltoFilas, saltoColumnas);
+    }
+    VistaMatriz rangoFilas(int fila0, int numFilas) const { return vista().rangoFilas(fila0, numFilas); }
+    VistaMatriz rangoColumnas(int columna0, int numColumnas) const {
+        return vista().rangoColumnas(columna0, numColumnas);
+    }
+
+    // Calcula la transpuesta (copia por bloques recursivos, ver copiarRecursivo)
+    Matriz transpuesta() const {
+        return Matriz(vistaTranspuesta());
+    }
+
+    // Producto de dos vistas con el núcleo por bloques (gemm), en paralelo
+    // con gemm::getHilos() hilos cuando es grande. Las vistas transpuestas o
+    // con saltos se empaquetan directamente, sin copiarlas antes.
+    static Matriz producto(const VistaMatriz& a, const VistaMatriz& b) {
+        if (a.getColumnas() != b.getFilas()) {
+            cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+            return Matriz(1, 1, true, "Error");
+        }
+
+        Matriz resultado(a.getFilas(), b.getColumnas(), true, a.getNombre() + "×" + b.getNombre());
+        gemm::multiplicarParalelo(a, b, resultado.datos, resultado.paso);
+        return resultado;
+    }
+
+    // Multiplica por otra matriz o vista
+    Matriz multiplicar(const VistaMatriz& otra) const {
+        return producto(vista(), otra);
+    }
+
+    // Multiplica con Strassen-Winograd (O(n^2.81)). Pensado para productos
+    // grandes (n >= 2048); el error crece con la profundidad de la recursión
+    // (ver pruebas de rendimiento), por eso operator* sigue siendo clásico.
+    // Una vista con saltos entre columnas se materializa antes.
+    Matriz multiplicarStrassen(const VistaMatriz& otra, int corte = gemm::CORTE_STRASSEN) const {
+        if (columnas != otra.getFilas()) {
+            cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+            return Matriz(1, 1, true, "Error");
+        }
+        if (otra.getPasoColumna() != 1)
+            return multiplicarStrassen(Matriz(otra), corte);
+
+        Matriz resultado(filas, otra.getColumnas(), false, nombre + "×" + otra.getNombre());
+        gemm::multiplicarStrassen(filas, otra.getColumnas(), columnas, datos, paso, otra.getDatos(),
+                                  (int)otra.getPasoFila(), resultado.datos, resultado.paso, corte);
+        return resultado;
+    }
+
+    // Triple bucle i-j-k original; se conserva como referencia para verificar
+    Matriz multiplicarIngenuo(const Matriz& otra) const {
+        if (columnas != otra.filas) {
+            cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+            return Matriz(1, 1, true, "Error");
+        }
+
+        Matriz resultado(filas, otra.columnas, true, nombre + "×" + otra.nombre);
+        for (int i = 0; i < filas; i++)
+            for (int j = 0; j < otra.columnas; j++)
+                for (int k = 0; k < columnas; k++)
+                    resultado.fila(i)[j] += fila(i)[k] * otra.fila(k)[j];
+        return resultado;
+    }
+
+    // Sistemas lineales mediante descomposición LU (definidas tras DescomposicionLU).
+    // Para varios sistemas con la misma matriz conviene factorizar una vez
+    // con DescomposicionLU y llamar a su resolver().
+    Matriz resolver(const VistaMatriz& b) const;    // X tal que A X = B
+    double determinante() const;
+    Matriz inversa() const;
+
+    // Sobrescribe los elementos con valores aleatorios, sin reservar memoria
+    void llenarAleatorio(const aleatorio::Distribucion& distribucion, uint64_t semilla) {
+        aleatorio::llenar(datos, filas, columnas, paso, distribucion, semilla);
+    }
+
+    // Imprime la matriz
+    void imprimir(int precision = 2) const {
+        vista().imprimir(precision);
+    }
+
+    // Establece o obtiene valores individuales
+    void setValor(int i, int j, double valor) {
+        if (i >= 0 && i < filas && j >= 0 && j < columnas)
+            fila(i)[j] = valor;
+        else
+            cerr << "Error: Índices fuera de rango.\n";
+    }
+
+    double getValor(int i, int j) const {
+        if (i >= 0 && i < filas && j >= 0 && j < columnas)
+            return fila(i)[j];
+        cerr << "Error: Índices fuera de rango.\n";
+        return 0.0;
+    }
+};
+
+//  EVALUACION DE EXPRESIONES DE PRODUCTO
+
+// C += alfa * (producto de los factores i..j), con C ya dimensionada
+template <size_t N>
+void ExpresionProducto<N>::evaluarRango(const Plan& plan, int i, int j, double alfa,
+                                        double* c, int pasoC) const {
+    if (i == j) {
+        // Solo ocurre con un único factor (escalar * A)
+        const VistaMatriz& f = factores[i];
+        for (int r = 0; r < f.getFilas(); r++)
+            for (int s = 0; s < f.getColumnas(); s++)
+                c[(size_t)r * pasoC + s] += alfa * f(r, s);
+        return;
+    }
+
+    int k = plan.corte[i][j];
+    optional<Matriz> temporalIzquierdo, temporalDerecho;
+    VistaMatriz izquierda = factores[i], derecha = factores[j];
+    if (k > i) {
+        temporalIzquierdo.emplace(factores[i].getFilas(), factores[k].getColumnas(), true, "T");
+        evaluarRango(plan, i, k, 1.0, temporalIzquierdo->getDatos(), temporalIzquierdo->getPaso());
+        izquierda = temporalIzquierdo->vista();
+    }
+    if (k + 1 < j) {
+        temporalDerecho.emplace(factores[k + 1].getFilas(), factores[j].getColumnas(), true, "T");
+        evaluarRango(plan, k + 1, j, 1.0, temporalDerecho->getDatos(), temporalDerecho->getPaso());
+        derecha = temporalDerecho->vista();
+    }
+    gemm::multiplicarParalelo(izquierda, derecha, c, pasoC, alfa);
+}
+
+// Indica si los rangos [a, a + na) y [b, b + nb) comparten memoria
+inline bool solapa(const double* a, size_t na, const double* b, size_t nb) {
+    if (na == 0 || nb == 0 || a == nullptr || b == nullptr)
+        return false;
+    return less<const double*>()(a, b + nb) && less<const double*>()(b, a + na);
+}
+
+// Elementos desde el primero hasta el último que lee la vista
+inline size_t extension(const VistaMatriz& v) {
+    if (v.getFilas() == 0 || v.getColumnas() == 0)
+        return 0;
+    return (size_t)((v.getFilas() - 1) * v.getPasoFila() + (v.getColumnas() - 1) * v.getPasoColumna() + 1);
+}
+
+// Indica si la vista lee memoria del bloque de la matriz
+inline bool solapa(const VistaMatriz& v, const Matriz& m) {
+    return solapa(v.getDatos(), extension(v), m.getDatos(), (size_t)m.getFilas() * m.getPaso());
+}
+
+template <size_t N>
+void ExpresionProducto<N>::evaluarEn(Matriz& destino) const {
+    if (!esValida()) {
+        cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+        destino = Matriz(1, 1, true, "Error");
+        return;
+    }
+
+    Plan plan = planificar();
+    int filas = getFilas(), columnas = getColumnas();
+    bool reutilizar = destino.getFilas() == filas && destino.getColumnas() == columnas &&
+                      destino.getDatos() != nullptr;
+    for (const VistaMatriz& f : factores)
+        if (solapa(f, destino))
+            reutilizar = false;
+
+    if (reutilizar) {
+        memset(destino.getDatos(), 0, (size_t)filas * destino.getPaso() * sizeof(double));
+        evaluarRango(plan, 0, (int)N - 1, escalar, destino.getDatos(), destino.getPaso());
+        destino.setNombre(getNombre());
+    } else {
+        Matriz resultado(filas, columnas, true, getNombre());
+        evaluarRango(plan, 0, (int)N - 1, escalar, resultado.getDatos(), resultado.getPaso());
+        destino = move(resultado);
+    }
+}
+
+//  OPERACIONES EN SITIO (BLAS)
+// Variantes de nivel 3, 2 y 1 que escriben en memoria ya existente, para
+// bucles iterativos que no deben crear temporales. Tras la primera llamada
+// de cada hilo (que reserva los paneles empaquetados) no reservan memoria.
+// Como en BLAS, la salida no puede compartir memoria con las entradas.
+namespace blas {
+
+// Umbral de elementos a partir del cual gemv y ger se reparten entre hilos
+const long long UMBRAL_PARALELO = 1LL << 18;
+const int FILAS_POR_TAREA = 256;
+
+// Producto punto de dos arreglos contiguos
+inline double productoPunto(int n, const double* x, const double* y) {
+    int j = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    for (; j + 8 <= n; j += 8) {
+        s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + j), _mm256_loadu_pd(y + j), s0);
+        s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + j + 4), _mm256_loadu_pd(y + j + 4), s1);
+    }
+    double parcial[4];
+    _mm256_storeu_pd(parcial, _mm256_add_pd(s0, s1));
+    double suma = (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]);
+#else
+    // Cuatro sumas independientes para no encadenar cada suma con la anterior
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    for (; j + 4 <= n; j += 4) {
+        s0 += x[j] * y[j];
+        s1 += x[j + 1] * y[j + 1];
+        s2 += x[j + 2] * y[j + 2];
+        s3 += x[j + 3] * y[j + 3];
+    }
+    double suma = (s0 + s1) + (s2 + s3);
+#endif
+    for (; j < n; j++)
+        suma += x[j] * y[j];
+    return suma;
+}
+
+// Ejecuta f(inicio, fin) sobre tramos de filas, en paralelo si el trabajo
+// (elementos tocados) lo justifica
+template <typename Funcion>
+void repartirFilas(int filas, long long elementos, const Funcion& f) {
+    long long tareas = (filas + FILAS_POR_TAREA - 1) / FILAS_POR_TAREA;
+    if (gemm::getHilos() <= 1 || elementos < UMBRAL_PARALELO || tareas < 2) {
+        f(0, filas);
+        return;
+    }
+    gemm::grupo().paraCada(tareas, [&](long long t) {
+        int inicio = (int)t * FILAS_POR_TAREA;
+        f(inicio, min(filas, inicio + FILAS_POR_TAREA));
+    });
+}
+
+// C = alfa * A * B + beta * C. Con beta = 0 el contenido previo de C se
+// ignora (aunque tenga NaN), como en BLAS.
+inline void gemm(double alfa, const VistaMatriz& a, const VistaMatriz& b, double beta, Matriz& c) {
+    if (a.getColumnas() != b.getFilas() || c.getFilas() != a.getFilas() ||
+        c.getColumnas() != b.getColumnas()) {
+        cerr << "Error: Dimensiones incompatibles en gemm.\n";
+        return;
+    }
+    if (solapa(a, c) || solapa(b, c)) {
+        cerr << "Error: C no puede compartir memoria con A ni con B.\n";
+        return;
+    }
+
+    int m = c.getFilas(), n = c.getColumnas();
+    if (beta == 0.0)
+        gemm::anular(m, n, c.getDatos(), c.getPaso());
+    else if (beta != 1.0)
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < n; j++)
+                c.fila(i)[j] *= beta;
+
+    if (alfa != 0.0 && a.getColumnas() > 0)
+        gemm::multiplicarParalelo(a, b, c.getDatos(), c.getPaso(), alfa);
+}
+
+// y = alfa * A * x + beta * y, con x de A.getColumnas() elementos e y de
+// A.getFilas(). A puede ser una vista transpuesta o con saltos.
+inline void gemv(double alfa, const VistaMatriz& a, const double* x, double beta, double* y) {
+    int m = a.getFilas(), n = a.getColumnas();
+    if (solapa(y, m, x, n) || solapa(y, m, a.getDatos(), extension(a))) {
+        cerr << "Error: y no puede compartir memoria con A ni con x.\n";
+        return;
+    }
+    ptrdiff_t pasoFila = a.getPasoFila(), pasoColumna = a.getPasoColumna();
+    const double* datos = a.getDatos();
+
+    repartirFilas(m, (long long)m * n, [&](int inicio, int fin) {
+        for (int i = inicio; i < fin; i++)
+            y[i] = beta == 0.0 ? 0.0 : beta * y[i];
+        if (alfa == 0.0)
+            return;
+        if (pasoColumna == 1) {
+            // Filas contiguas: un producto punto por fila
+            for (int i = inicio; i < fin; i++)
+                y[i] += alfa * productoPunto(n, datos + i * pasoFila, x);
+        } else if (pasoFila == 1) {
+            // Columnas contiguas (vista transpuesta): y += (alfa * x[j]) * columna j
+            for (int j = 0; j < n; j++) {
+                double factor = alfa * x[j];
+                const double* columna = datos + j * pasoColumna;
+                for (int i = inicio; i < fin; i++)
+                    y[i] += factor * columna[i];
+            }
+        } else {
+            for (int i = inicio; i < fin; i++) {
+                double suma = 0.0;
+                for (int j = 0; j < n; j++)
+                    suma += datos[i * pasoFila + j * pasoColumna] * x[j];
+                y[i] += alfa * suma;
+            }
+        }
+    });
+}
+
+inline void gemv(double alfa, const VistaMatriz& a, const vector<double>& x, double beta,
+                 vector<double>& y) {
+    if ((int)x.size() != a.getColumnas() || (int)y.size() != a.getFilas()) {
+        cerr << "Error: Dimensiones incompatibles en gemv.\n";
+        return;
+    }
+    gemv(alfa, a, x.data(), beta, y.data());
+}
+
+// A = A + alfa * x * y^T (actualización de rango 1), con x de A.getFilas()
+// elementos e y de A.getColumnas()
+inline void ger(double alfa, const double* x, const double* y, Matriz& a) {
+    int m = a.getFilas(), n = a.getColumnas();
+    size_t elementos = (size_t)m * a.getPaso();
+    if (solapa(x, m, a.getDatos(), elementos) || solapa(y, n, a.getDatos(), elementos)) {
+        cerr << "Error: x e y no pueden compartir memoria con A.\n";
+        return;
+    }
+    if (alfa == 0.0)
+        return;
+    repartirFilas(m, (long long)m * n, [&](int inicio, int fin) {
+        for (int i = inicio; i < fin; i++) {
+            double factor = alfa * x[i];
+            double* fila = a.fila(i);
+            for (int j = 0; j < n; j++)
+                fila[j] += factor * y[j];
+        }
+    });
+}
+
+inline void ger(double alfa, const vector<double>& x, const vector<double>& y, Matriz& a) {
+    if ((int)x.size() != a.getFilas() || (int)y.size() != a.getColumnas()) {
+        cerr << "Error: Dimensiones incompatibles en ger.\n";
+        return;
+    }
+    ger(alfa, x.data(), y.data(), a);
+}
+
+} // namespace blas
+
+//  CLASE MATRIZ DISPERSA
+// Matriz en formato CSR (filas comprimidas): solo guarda los elementos
+// distintos de cero. Para cada fila i, sus elementos son
+// valores[inicioFila[i] .. inicioFila[i + 1]) en las columnas
+// indiceColumna[...], ordenadas de menor a mayor.
+// transpuesta() reordena los mismos arreglos por columnas, así que sus
+// arreglos son la representación CSC de la matriz original.
+class MatrizDispersa {
+public:
+    // Por debajo de esta densidad (fracción de elementos distintos de cero)
+    // los productos dispersos ganan al núcleo denso por bloques. Medido con
+    // la opción 9 del menú de rendimiento (n = 1000 y 2000, AVX2, 1 hilo):
+    // disperso × denso empata hacia el 10 % y denso × disperso hacia el 6 %
+    static constexpr double UMBRAL_DENSIDAD = 0.05;
+
+private:
+    int filas;
+    int columnas;
+    vector<long long> inicioFila;    // filas + 1 posiciones
+    vector<int> indiceColumna;       // Columna de cada elemento guardado
+    vector<double> valores;          // Valor de cada elemento guardado
+    string nombre;
+
+public:
+    // Matriz vacía (todos los elementos en cero)
+    MatrizDispersa(int filas, int columnas, string nombre = "S")
+        : filas(filas), columnas(columnas), inicioFila(filas + 1, 0), nombre(nombre) {}
+
+    // Convierte una matriz densa (o vista) guardando solo los no ceros
+    explicit MatrizDispersa(const VistaMatriz& densa)
+        : filas(densa.getFilas()), columnas(densa.getColumnas()), inicioFila(filas + 1, 0),
+          nombre(densa.getNombre()) {
+        long long total = 0;
+        for (int i = 0; i < filas; i++)
+            for (int j = 0; j < columnas; j++)
+                total += densa(i, j) != 0.0;
+        indiceColumna.reserve(total);
+        valores.reserve(total);
+        for (int i = 0; i < filas; i++) {
+            for (int j = 0; j < columnas; j++) {
+                double valor = densa(i, j);
+                if (valor != 0.0) {
+                    indiceColumna.push_back(j);
+                    valores.push_back(valor);
+                }
+            }
+            inicioFila[i + 1] = (long long)valores.size();
+        }
+    }
+
+    int getFilas() const { return filas; }
+    int getColumnas() const { return columnas; }
+    long long getNoCeros() const { return (long long)valores.size(); }
+    string getNombre() const { return nombre; }
+    void setNombre(const string& nuevo) { nombre = nuevo; }
+    const vector<long long>& getInicioFila() const { return inicioFila; }
+    const vector<int>& getIndiceColumna() const { return indiceColumna; }
+    const vector<double>& getValores() const { return valores; }
+
+    double getDensidad() const {
+        return filas == 0 || columnas == 0 ? 0.0 : (double)getNoCeros() / ((double)filas * columnas);
+    }
+
+    // Acceso a un elemento por búsqueda binaria en su fila
+    double getValor(int i, int j) const {
+        if (i < 0 || i >= filas || j < 0 || j >= columnas) {
+            cerr << "Error: Índice fuera de rango.\n";
+            return 0.0;
+        }
+        auto inicio = indiceColumna.begin() + inicioFila[i];
+        auto fin = indiceColumna.begin() + inicioFila[i + 1];
+        auto posicion = lower_bound(inicio, fin, j);
+        return posicion != fin && *posicion == j ? valores[posicion - indiceColumna.begin()] : 0.0;
+    }
+
+    // Convierte de vuelta a una matriz densa
+    Matriz aDensa() const {
+        Matriz densa(filas, columnas, true, nombre);
+        for (int i = 0; i < filas; i++) {
+            double* fila = densa.fila(i);
+            for (long long p = inicioFila[i]; p < inicioFila[i + 1]; p++)
+                fila[indiceColumna[p]] = valores[p];
+        }
+        return densa;
+    }
+
+    // Transpuesta por conteo de columnas, O(no ceros)
+    MatrizDispersa transpuesta() const {
+        MatrizDispersa t(columnas, filas, nombre + "^T");
+        for (int c : indiceColumna)
+            t.inicioFila[c + 1]++;
+        for (int j = 0; j < columnas; j++)
+            t.inicioFila[j + 1] += t.inicioFila[j];
+        t.indiceColumna.resize(valores.size());
+        t.valores.resize(valores.size());
+        vector<long long> siguiente(t.inicioFila.begin(), t.inicioFila.end() - 1);
+        for (int i = 0; i < filas; i++)
+            for (long long p = inicioFila[i]; p < inicioFila[i + 1]; p++) {
+                long long destino = siguiente[indiceColumna[p]]++;
+                t.indiceColumna[destino] = i;
+                t.valores[destino] = valores[p];
+            }
+        return t;
+    }
+
+    // y = alfa * S * x + beta * y en sitio (x de columnas elementos, y de filas)
+    void multiplicarVector(double alfa, const double* x, double beta, double* y) const {
+        blas::repartirFilas(filas, 2 * getNoCeros(), [&](int inicio, int fin) {
+            for (int i = inicio; i < fin; i++) {
+                double suma = 0.0;
+                for (long long p = inicioFila[i]; p < inicioFila[i + 1]; p++)
+                    suma += valores[p] * x[indiceColumna[p]];
+                y[i] = (beta == 0.0 ? 0.0 : beta * y[i]) + alfa * suma;
+            }
+        });
+    }
+
+    vector<double> multiplicar(const vector<double>& x) const {
+        vector<double> y(filas, 0.0);
+        if ((int)x.size() != columnas) {
+            cerr << "Error: El vector debe tener tantos elementos como columnas la matriz.\n";
+            return y;
+        }
+        multiplicarVector(1.0, x.data(), 0.0, y.data());
+        return y;
+    }
+
+    // Disperso × denso: cada no cero S(i, k) suma S(i, k) * fila k de B a la
+    // fila i del resultado (recorrido contiguo y vectorizable si B lo es)
+    Matriz multiplicar(const VistaMatriz& b) const {
+        if (columnas != b.getFilas()) {
+            cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+            return Matriz(1, 1, true, "Error");
+        }
+        int n = b.getColumnas();
+        Matriz resultado(filas, n, true, nombre + "×" + b.getNombre());
+        ptrdiff_t pasoFilaB = b.getPasoFila(), pasoColumnaB = b.getPasoColumna();
+        blas::repartirFilas(filas, getNoCeros() * n, [&](int inicio, int fin) {
+            for (int i = inicio; i < fin; i++) {
+                double* c = resultado.fila(i);
+                for (long long p = inicioFila[i]; p < inicioFila[i + 1]; p++) {
+                    double valor = valores[p];
+                    const double* filaB = b.getDatos() + indiceColumna[p] * pasoFilaB;
+                    if (pasoColumnaB == 1)
+                        for (int j = 0; j < n; j++)
+                            c[j] += valor * filaB[j];
+                    else
+                        for (int j = 0; j < n; j++)
+                            c[j] += valor * filaB[j * pasoColumnaB];
+                }
+            }
+        });
+        return resultado;
+    }
+
+    // Disperso × disperso (Gustavson): la fila i del resultado combina las
+    // filas de B indicadas por los no ceros de la fila i de A. Una pasada
+    // simbólica cuenta los no ceros de cada fila y la numérica los escribe
+    // directamente en su lugar, así las filas se reparten entre hilos.
+    MatrizDispersa multiplicar(const MatrizDispersa& b) const {
+        if (columnas != b.filas) {
+            cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+            return MatrizDispersa(1, 1, "Error");
+        }
+        MatrizDispersa resultado(filas, b.columnas, nombre + "×" + b.nombre);
+        long long trabajo = b.filas == 0 ? 0 : getNoCeros() * (b.getNoCeros() / b.filas + 1);
+
+        blas::repartirFilas(filas, trabajo, [&](int inicio, int fin) {
+            thread_local vector<int> marca;
+            marca.assign(b.columnas, -1);
+            for (int i = inicio; i < fin; i++) {
+                long long cuenta = 0;
+                for (long long p = inicioFila[i]; p < inicioFila[i + 1]; p++) {
+                    int k = indiceColumna[p];
+                    for (long long q = b.inicioFila[k]; q < b.inicioFila[k + 1]; q++)
+                        if (marca[b.indiceColumna[q]] != i) {
+                            marca[b.indiceColumna[q]] = i;
+                            cuenta++;
+                        }
+                }
+                resultado.inicioFila[i + 1] = cuenta;
+            }
+        });
+        for (int i = 0; i < filas; i++)
+            resultado.inicioFila[i + 1] += resultado.inicioFila[i];
+        resultado.indiceColumna.resize(resultado.inicioFila[filas]);
+        resultado.valores.resize(resultado.inicioFila[filas]);
+
+        blas::repartirFilas(filas, trabajo, [&](int inicio, int fin) {
+            thread_local vector<int> marca;
+            thread_local vector<double> acumulado;
+            marca.assign(b.columnas, -1);
+            acumulado.resize(b.columnas);
+            for (int i = inicio; i < fin; i++) {
+                long long siguiente = resultado.inicioFila[i];
+                for (long long p = inicioFila[i]; p < inicioFila[i + 1]; p++) {
+                    int k = indiceColumna[p];
+                    double valor = valores[p];
+                    for (long long q = b.inicioFila[k]; q < b.inicioFila[k + 1]; q++) {
+                        int j = b.indiceColumna[q];
+                        if (marca[j] != i) {
+                            marca[j] = i;
+                            acumulado[j] = valor * b.valores[q];
+                            resultado.indiceColumna[siguiente++] = j;
+                        } else {
+                            acumulado[j] += valor * b.valores[q];
+                        }
+                    }
+                }
+                int* columnasFila = resultado.indiceColumna.data() + resultado.inicioFila[i];
+                int* finFila = resultado.indiceColumna.data() + siguiente;
+                sort(columnasFila, finFila);
+                for (int* c = columnasFila; c < finFila; c++)
+                    resultado.valores[c - resultado.indiceColumna.data()] = acumulado[*c];
+            }
+        });
+        return resultado;
+    }
+
+    // Densidad de una matriz densa. Deja de contar en cuanto supera "limite"
+    // y entonces devuelve un valor apenas mayor que este
+    static double medirDensidad(const VistaMatriz& m, double limite = 1.0) {
+        long long total = (long long)m.getFilas() * m.getColumnas();
+        if (total == 0)
+            return 0.0;
+        long long maximo = (long long)(limite * total), noCeros = 0;
+        for (int i = 0; i < m.getFilas() && noCeros <= maximo; i++)
+            for (int j = 0; j < m.getColumnas(); j++)
+                noCeros += m(i, j) != 0.0;
+        return (double)noCeros / total;
+    }
+
+    void imprimir(int precision = 2) const {
+        cout << "Matriz dispersa " << nombre << " (" << filas << "x" << columnas << ", "
+             << getNoCeros() << " no ceros)\n";
+        aDensa().imprimir(precision);
+    }
+};
+
+// Denso × disperso: la fila i del resultado suma A(i, k) * fila k de S
+inline Matriz multiplicar(const VistaMatriz& a, const MatrizDispersa& s) {
+    if (a.getColumnas() != s.getFilas()) {
+        cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+        return Matriz(1, 1, true, "Error");
+    }
+    Matriz resultado(a.getFilas(), s.getColumnas(), true, a.getNombre() + "×" + s.getNombre());
+    const vector<long long>& inicioFila = s.getInicioFila();
+    const vector<int>& indiceColumna = s.getIndiceColumna();
+    const vector<double>& valores = s.getValores();
+    blas::repartirFilas(a.getFilas(), (long long)a.getFilas() * s.getNoCeros(),
+                        [&](int inicio, int fin) {
+        for (int i = inicio; i < fin; i++) {
+            double* c = resultado.fila(i);
+            for (int k = 0; k < a.getColumnas(); k++) {
+                double valor = a(i, k);
+                if (valor == 0.0)
+                    continue;
+                for (long long p = inicioFila[k]; p < inicioFila[k + 1]; p++)
+                    c[indiceColumna[p]] += valor * valores[p];
+            }
+        }
+    });
+    return resultado;
+}
+
+// Producto que elige la ruta según la densidad medida de los operandos:
+// si alguno tiene menos de UMBRAL_DENSIDAD de no ceros se convierte a CSR
+// (la conversión cuesta una lectura, despreciable frente al producto)
+inline Matriz multiplicarAutomatico(const VistaMatriz& a, const VistaMatriz& b) {
+    if (a.getColumnas() != b.getFilas())
+        return Matriz::producto(a, b);
+    const double umbral = MatrizDispersa::UMBRAL_DENSIDAD;
+    if (MatrizDispersa::medirDensidad(a, umbral) < umbral)
+        return MatrizDispersa(a).multiplicar(b);
+    if (MatrizDispersa::medirDensidad(b, umbral) < umbral)
+        return multiplicar(a, MatrizDispersa(b));
+    return Matriz::producto(a, b);
+}
+
+//  ARCHIVOS BINARIOS DE MATRICES
+// Formato (versión 1), pensado para abrirse con mmap sin leer ni convertir:
+//   bytes 0-63   cabecera (CabeceraArchivo, abajo), en el orden de bytes de
+//                la máquina que escribió; "ordenBytes" permite detectarlo
+//   bytes 64-    nombre de la matriz (longitudNombre bytes, sin '\0')
+//   inicioDatos  filas × paso elementos por filas; inicioDatos es múltiplo
+//                de "alineacion" (64) y el relleno de cada fila vale cero
+// Como mmap devuelve memoria alineada a página, las filas quedan alineadas
+// igual que en Matriz y la vista mapeada se multiplica sin copiarse.
+struct CabeceraArchivo {
+    char firma[8];            // "MATRIZ\0\0"
+    uint32_t version;         // VERSION_ARCHIVO
+    uint32_t ordenBytes;      // ORDEN_BYTES tal como lo guardó la máquina
+    uint32_t tipo;            // TIPO_DOUBLE: double IEEE-754 de 8 bytes
+    uint32_t alineacion;      // Bytes a los que se alinea inicioDatos
+    uint64_t filas;
+    uint64_t columnas;
+    uint64_t paso;            // Elementos entre el inicio de dos filas
+    uint64_t inicioDatos;     // Desplazamiento en bytes de la primera fila
+    uint32_t longitudNombre;
+    uint32_t reservado;       // Cero
+};
+static_assert(sizeof(CabeceraArchivo) == 64, "La cabecera debe ocupar 64 bytes");
+
+const char FIRMA_ARCHIVO[8] = {'M', 'A', 'T', 'R', 'I', 'Z', '\0', '\0'};
+const uint32_t VERSION_ARCHIVO = 1;
+const uint32_t ORDEN_BYTES = 0x01020304;
+const uint32_t TIPO_DOUBLE = 1;
+
+// Escribe la cabecera y el nombre, con el relleno hasta inicioDatos
+inline CabeceraArchivo escribirCabecera(ostream& archivo, int filas, int columnas, const string& nombre) {
+    uint64_t finNombre = sizeof(CabeceraArchivo) + nombre.size();
+    CabeceraArchivo cabecera = {};
+    memcpy(cabecera.firma, FIRMA_ARCHIVO, sizeof(cabecera.firma));
+    cabecera.version = VERSION_ARCHIVO;
+    cabecera.ordenBytes = ORDEN_BYTES;
+    cabecera.tipo = TIPO_DOUBLE;
+    cabecera.alineacion = Matriz::ALINEACION;
+    cabecera.filas = filas;
+    cabecera.columnas = columnas;
+    cabecera.paso = (columnas + Matriz::ELEMENTOS_LINEA - 1) / Matriz::ELEMENTOS_LINEA *
+                    Matriz::ELEMENTOS_LINEA;
+    cabecera.inicioDatos = (finNombre + Matriz::ALINEACION - 1) / Matriz::ALINEACION * Matriz::ALINEACION;
+    cabecera.longitudNombre = (uint32_t)nombre.size();
+
+    const char ceros[Matriz::ALINEACION] = {};
+    archivo.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    archivo.write(nombre.data(), nombre.size());
+    archivo.write(ceros, cabecera.inicioDatos - finNombre);
+    return cabecera;
+}
+
+// Comprueba una cabecera contra el tamaño real del archivo
+inline bool validarCabecera(const CabeceraArchivo& c, size_t bytes, const string& ruta) {
+    const char* motivo = nullptr;
+    if (memcmp(c.firma, FIRMA_ARCHIVO, sizeof(c.firma)) != 0)
+        motivo = "no es un archivo de matriz";
+    else if (c.ordenBytes != ORDEN_BYTES)
+        motivo = "fue escrito con otro orden de bytes";
+    else if (c.version != VERSION_ARCHIVO)
+        motivo = "version de formato no soportada";
+    else if (c.tipo != TIPO_DOUBLE)
+        motivo = "tipo de elemento no soportado";
+    else if (c.filas == 0 || c.columnas == 0 || c.filas > (uint64_t)numeric_limits<int>::max() ||
+             c.paso < c.columnas || c.paso > (uint64_t)numeric_limits<int>::max())
+        motivo = "dimensiones invalidas";
+    else if (c.inicioDatos % alignof(double) != 0 ||
+             c.inicioDatos < sizeof(CabeceraArchivo) + c.longitudNombre || c.inicioDatos > bytes ||
+             (bytes - c.inicioDatos) / sizeof(double) / c.paso < c.filas)
+        motivo = "archivo truncado o cabecera inconsistente";
+    if (motivo != nullptr) {
+        cerr << "Error: " << ruta << ": " << motivo << ".\n";
+        return false;
+    }
+    return true;
+}
+
+// Escribe la matriz (o vista) fila por fila, sin materializarla: solo usa
+// un búfer de una fila cuando la vista no tiene columnas contiguas
+inline bool guardarBinario(const VistaMatriz& m, const string& ruta) {
+    ofstream archivo(ruta, ios::binary | ios::trunc);
+    if (!archivo) {
+        cerr << "Error: No se pudo crear el archivo " << ruta << ".\n";
+        return false;
+    }
+
+    CabeceraArchivo cabecera = escribirCabecera(archivo, m.getFilas(), m.getColumnas(), m.getNombre());
+    int paso = (int)cabecera.paso;
+    const char ceros[Matriz::ALINEACION] = {};
+    vector<double> fila(paso, 0.0);
+    for (int i = 0; i < m.getFilas() && archivo; i++) {
+        const double* origen = m.getDatos() + i * m.getPasoFila();
+        if (m.getPasoColumna() == 1) {
+            archivo.write(reinterpret_cast<const char*>(origen), m.getColumnas() * sizeof(double));
+            archivo.write(ceros, (paso - m.getColumnas()) * sizeof(double));
+        } else {
+            for (int j = 0; j < m.getColumnas(); j++)
+                fila[j] = origen[j * m.getPasoColumna()];
+            archivo.write(reinterpret_cast<const char*>(fila.data()), paso * sizeof(double));
+        }
+    }
+
+    archivo.close();
+    if (!archivo) {
+        cerr << "Error: No se pudo escribir el archivo " << ruta << ".\n";
+        return false;
+    }
+    return true;
+}
+
+// Matriz de solo lectura proyectada desde un archivo binario. Abrirla solo
+// valida la cabecera: el sistema lee cada página la primera vez que se
+// toca, así que el costo no depende del tamaño. Los datos viven mientras
+// viva el objeto; no se puede copiar ni mover porque sus vistas apuntan a él.
+class MatrizMapeada {
+private:
+    const char* mapa;        // Archivo completo en memoria
+    size_t bytesMapa;
+    vector<double> respaldo; // Copia del archivo si no hay mmap
+    VistaMatriz datos;
+    string nombre;
+
+public:
+    explicit MatrizMapeada(const string& ruta) : mapa(nullptr), bytesMapa(0) {
+        const char* base = nullptr;
+        size_t bytes = 0;
+#if defined(__unix__) || defined(__APPLE__)
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+        struct stat estado;
+        if (descriptor < 0 || fstat(descriptor, &estado) != 0) {
+            cerr << "Error: No se pudo abrir el archivo " << ruta << ".\n";
+            if (descriptor >= 0)
+                close(descriptor);
+            return;
+        }
+        bytes = (size_t)estado.st_size;
+        if (bytes >= sizeof(CabeceraArchivo)) {
+            void* p = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (p != MAP_FAILED) {
+                mapa = base = static_cast<const char*>(p);
+                bytesMapa = bytes;
+            }
+        }
+        close(descriptor);   // La proyección sigue válida sin el descriptor
+#else
+        ifstream archivo(ruta, ios::binary | ios::ate);
+        if (!archivo) {
+            cerr << "Error: No se pudo abrir el archivo " << ruta << ".\n";
+            return;
+        }
+        bytes = (size_t)archivo.tellg();
+        respaldo.resize((bytes + sizeof(double) - 1) / sizeof(double));
+        archivo.seekg(0);
+        if (archivo.read(reinterpret_cast<char*>(respaldo.data()), bytes))
+            base = reinterpret_cast<const char*>(respaldo.data());
+#endif
+        if (base == nullptr || bytes < sizeof(CabeceraArchivo)) {
+            cerr << "Error: No se pudo leer el archivo " << ruta << ".\n";
+            return;
+        }
+
+        CabeceraArchivo cabecera;
+        memcpy(&cabecera, base, sizeof(cabecera));
+        if (!validarCabecera(cabecera, bytes, ruta))
+            return;
+        nombre.assign(base + sizeof(CabeceraArchivo), cabecera.longitudNombre);
+        datos = VistaMatriz(reinterpret_cast<const double*>(base + cabecera.inicioDatos),
+                            (int)cabecera.filas, (int)cabecera.columnas, (ptrdiff_t)cabecera.paso, 1,
+                            &nombre);
+    }
+
+    ~MatrizMapeada() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapa != nullptr)
+            munmap(const_cast<char*>(mapa), bytesMapa);
+#endif
+    }
+
+    MatrizMapeada(const MatrizMapeada&) = delete;
+    MatrizMapeada& operator=(const MatrizMapeada&) = delete;
+
+    bool esValida() const { return datos.getFilas() > 0; }
+    int getFilas() const { return datos.getFilas(); }
+    int getColumnas() const { return datos.getColumnas(); }
+    string getNombre() const { return nombre; }
+
+    const VistaMatriz& vista() const { return datos; }
+    operator VistaMatriz() const { return datos; }
+};
+
+//  MULTIPLICACION FUERA DE MEMORIA
+// C = A * B con A, B y C en archivos binarios (formato de arriba) que no
+// tienen por qué caber en memoria. C se recorre por teselas; cada tesela
+// acumula los productos de una franja de A por una franja de B leídas del
+// disco. Mientras se calcula un paso, un hilo aparte ya lee las teselas del
+// siguiente y otro escribe la tesela de C anterior, así disco y CPU se
+// solapan. El presupuesto cubre los paneles empaquetados del núcleo, de
+// tamaño fijo (MC*KC + KC*NC por hilo), y con el resto se dimensionan los
+// búferes dobles (2 de A, 2 de B y 2 de C, todos de lado T).
+struct EstadisticasDisco {
+    int tesela = 0;                  // Lado T de las teselas
+    size_t bytesBuferes = 0;         // Memoria de teselas reservada
+    long long bytesLeidos = 0;
+    long long bytesEscritos = 0;
+    double segundos = 0.0;           // Tiempo total
+    double segundosEspera = 0.0;     // Tiempo de cálculo detenido esperando al disco
+};
+
+// Abre un archivo de matriz y valida su cabecera
+inline bool abrirOperando(ifstream& archivo, CabeceraArchivo& cabecera, const string& ruta) {
+    archivo.open(ruta, ios::binary | ios::ate);
+    if (!archivo) {
+        cerr << "Error: No se pudo abrir el archivo " << ruta << ".\n";
+        return false;
+    }
+    size_t bytes = (size_t)archivo.tellg();
+    archivo.seekg(0);
+    if (bytes < sizeof(cabecera) || !archivo.read(reinterpret_cast<char*>(&cabecera), sizeof(cabecera))) {
+        cerr << "Error: No se pudo leer el archivo " << ruta << ".\n";
+        return false;
+    }
+    return validarCabecera(cabecera, bytes, ruta);
+}
+
+// Lee el bloque [fila0, fila0 + nf) x [columna0, columna0 + nc) en destino,
+// con nc elementos por fila
+inline void leerTesela(ifstream& archivo, const CabeceraArchivo& c, int fila0, int columna0, int nf,
+                       int nc, double* destino) {
+    for (int i = 0; i < nf; i++) {
+        archivo.seekg(c.inicioDatos + ((uint64_t)(fila0 + i) * c.paso + columna0) * sizeof(double));
+        archivo.read(reinterpret_cast<char*>(destino + (size_t)i * nc), nc * sizeof(double));
+    }
+}
+
+inline void escribirTesela(ofstream& archivo, const CabeceraArchivo& c, int fila0, int columna0, int nf,
+                           int nc, const double* origen) {
+    for (int i = 0; i < nf; i++) {
+        archivo.seekp(c.inicioDatos + ((uint64_t)(fila0 + i) * c.paso + columna0) * sizeof(double));
+        archivo.write(reinterpret_cast<const char*>(origen + (size_t)i * nc), nc * sizeof(double));
+    }
+}
+
+inline bool multiplicarEnDisco(const string& rutaA, const string& rutaB, const string& rutaC,
+                               size_t presupuesto, EstadisticasDisco* estadisticas = nullptr) {
+    auto inicio = chrono::steady_clock::now();
+    ifstream archivoA, archivoB;
+    CabeceraArchivo a, b;
+    if (!abrirOperando(archivoA, a, rutaA) || !abrirOperando(archivoB, b, rutaB))
+        return false;
+    if (a.columnas != b.filas) {
+        cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+        return false;
+    }
+
+    // Seis búferes de T x T doubles; T múltiplo de 8 para no partir filas del núcleo
+    size_t paneles = gemm::bytesPaneles(), minimo = paneles + 6 * 8 * 8 * sizeof(double);
+    if (presupuesto < minimo) {
+        cerr << "Error: El presupuesto de memoria debe ser de al menos " << minimo << " bytes ("
+             << paneles << " de paneles del núcleo con " << gemm::getHilos() << " hilos).\n";
+        return false;
+    }
+    int lado = (int)sqrt((double)(presupuesto - paneles) / (6 * sizeof(double))) / 8 * 8;
+    int m = (int)a.filas, n = (int)b.columnas, k = (int)a.columnas;
+    int tm = min(lado, m), tn = min(lado, n), tk = min(lado, k);
+
+    string nombreA(a.longitudNombre, '\0'), nombreB(b.longitudNombre, '\0');
+    archivoA.seekg(sizeof(CabeceraArchivo));
+    archivoA.read(&nombreA[0], a.longitudNombre);
+    archivoB.seekg(sizeof(CabeceraArchivo));
+    archivoB.read(&nombreB[0], b.longitudNombre);
+
+    // C se crea con su tamaño final; los huecos (relleno de filas) quedan en cero
+    ofstream archivoC(rutaC, ios::binary | ios::trunc);
+    if (!archivoC) {
+        cerr << "Error: No se pudo crear el archivo " << rutaC << ".\n";
+        return false;
+    }
+    CabeceraArchivo c = escribirCabecera(archivoC, m, n, nombreA + "×" + nombreB);
+    archivoC.seekp(c.inicioDatos + (uint64_t)m * c.paso * sizeof(double) - 1);
+    archivoC.put('\0');
+
+    vector<double> bufferA[2], bufferB[2], bufferC[2];
+    for (int i = 0; i < 2; i++) {
+        bufferA[i].resize((size_t)tm * tk);
+        bufferB[i].resize((size_t)tk * tn);
+        bufferC[i].resize((size_t)tm * tn);
+    }
+
+    // Paso s: tesela (bi, bj) de C y franja bp de k, con bp variando más rápido
+    int bloquesM = (m + tm - 1) / tm, bloquesN = (n + tn - 1) / tn, bloquesK = (k + tk - 1) / tk;
+    long long pasos = (long long)bloquesM * bloquesN * bloquesK;
+    long long bytesLeidos = 0, bytesEscritos = 0;
+    auto cargar = [&](long long s) {
+        int bp = (int)(s % bloquesK), bj = (int)(s / bloquesK % bloquesN), bi = (int)(s / bloquesK / bloquesN);
+        int nf = min(tm, m - bi * tm), nc = min(tn, n - bj * tn), nk = min(tk, k - bp * tk);
+        leerTesela(archivoA, a, bi * tm, bp * tk, nf, nk, bufferA[s % 2].data());
+        leerTesela(archivoB, b, bp * tk, bj * tn, nk, nc, bufferB[s % 2].data());
+        bytesLeidos += ((long long)nf * nk + (long long)nk * nc) * sizeof(double);
+    };
+
+    double espera = 0.0;
+    auto esperar = [&](future<void>& tarea) {
+        auto antes = chrono::steady_clock::now();
+        tarea.get();
+        espera += chrono::duration<double>(chrono::steady_clock::now() - antes).count();
+    };
+
+    future<void> lectura = async(launch::async, cargar, 0LL), escritura;
+    long long teselaC = 0;
+    for (long long s = 0; s < pasos; s++) {
+        esperar(lectura);
+        if (s + 1 < pasos)
+            lectura = async(launch::async, cargar, s + 1);
+
+        int bp = (int)(s % bloquesK), bj = (int)(s / bloquesK % bloquesN), bi = (int)(s / bloquesK / bloquesN);
+        int nf = min(tm, m - bi * tm), nc = min(tn, n - bj * tn), nk = min(tk, k - bp * tk);
+        double* acumulado = bufferC[teselaC % 2].data();
+        if (bp == 0)
+            fill(acumulado, acumulado + (size_t)nf * nc, 0.0);
+        gemm::multiplicarParalelo(VistaMatriz(bufferA[s % 2].data(), nf, nk, nk, 1),
+                                  VistaMatriz(bufferB[s % 2].data(), nk, nc, nc, 1), acumulado, nc);
+
+        if (bp == bloquesK - 1) {
+            // La escritura anterior usaba el otro búfer de C; basta esperarla
+            // antes de lanzar esta para que nunca haya dos en curso
+            if (escritura.valid())
+                esperar(escritura);
+            escritura = async(launch::async, [&, bi, bj, nf, nc, acumulado]() {
+                escribirTesela(archivoC, c, bi * tm, bj * tn, nf, nc, acumulado);
+                bytesEscritos += (long long)nf * nc * sizeof(double);
+            });
+            teselaC++;
+        }
+    }
+    if (escritura.valid())
+        esperar(escritura);
+    archivoC.close();
+
+    if (!archivoA || !archivoB || !archivoC) {
+        cerr << "Error: Falló la lectura o escritura de los archivos.\n";
+        return false;
+    }
+    if (estadisticas != nullptr) {
+        estadisticas->tesela = lado;
+        estadisticas->bytesBuferes = 2 * ((size_t)tm * tk + (size_t)tk * tn + (size_t)tm * tn) * sizeof(double);
+        estadisticas->bytesLeidos = bytesLeidos;
+        estadisticas->bytesEscritos = bytesEscritos;
+        estadisticas->segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        estadisticas->segundosEspera = espera;
+    }
+    return true;
+}
+
+//  PRECISION SIMPLE Y MIXTA
+// Matriz trabaja siempre en double. MatrizDensa<T> guarda los elementos en
+// float o double con el mismo formato (por filas, paso de 64 bytes, bloque
+// del pool); con float la matriz ocupa la mitad y cada registro vectorial
+// procesa el doble de elementos. El producto usa un micro-núcleo genérico
+// que calcula en el tipo pedido y puede sumar a un resultado de otro tipo:
+// así se hace el producto mixto (datos en float, cálculo en double) y la
+// factorización LU en float del refinamiento iterativo.
+
+// Bytes de un registro vectorial, según las instrucciones con que se compila
+#if defined(__AVX512F__)
+const int BYTES_VECTOR = 64;
+#elif defined(__AVX__)
+const int BYTES_VECTOR = 32;
+#else
+const int BYTES_VECTOR = 16;
+#endif
+
+// Llama a f(0), f(1), ..., f(N-1) con índices constantes: el bucle queda
+// desenrollado aunque el compilador no lo haría por su cuenta (GCC en -O2)
+template <typename Funcion, int... I>
+inline void desenrollar(Funcion&& f, integer_sequence<int, I...>) {
+    (f(integral_constant<int, I>{}), ...);
+}
+
+template <int N, typename Funcion>
+inline void desenrollar(Funcion&& f) {
+    desenrollar(f, make_integer_sequence<int, N>{});
+}
+
+namespace gemm {
+
+// Columnas del micro-núcleo genérico: dos registros del tipo de cálculo
+// (8 double o 16 float con AVX2)
+template <typename T>
+constexpr int columnasNucleo() {
+    return 2 * BYTES_VECTOR / (int)sizeof(T);
+}
+
+// Como empaquetarA, convirtiendo cada elemento al tipo de cálculo T
+// (pasando antes por R, si los datos deben redondearse a otra precisión)
+template <typename T, typename R, typename TA>
+inline void empaquetarATipo(int mc, int kc, const TA* a, ptrdiff_t pasoFila, ptrdiff_t pasoColumna,
+                            T alfa, T* destino) {
+    for (int ir = 0; ir < mc; ir += MR) {
+        int filas = min(MR, mc - ir);
+        for (int p = 0; p < kc; p++) {
+            for (int i = 0; i < filas; i++)
+                destino[i] = alfa * (T)(R)a[(ir + i) * pasoFila + p * pasoColumna];
+            for (int i = filas; i < MR; i++)
+                destino[i] = 0;
+            destino += MR;
+        }
+    }
+}
+
+// Como empaquetarB, en tiras de columnasNucleo<T>() columnas
+template <typename T, typename R, typename TB>
+inline void empaquetarBTipo(int kc, int nc, const TB* b, ptrdiff_t pasoFila, ptrdiff_t pasoColumna,
+                            T* destino) {
+    constexpr int NT = columnasNucleo<T>();
+    for (int jr = 0; jr < nc; jr += NT) {
+        int columnas = min(NT, nc - jr);
+        for (int p = 0; p < kc; p++) {
+            const TB* fila = b + p * pasoFila + jr * pasoColumna;
+            if (pasoColumna == 1)
+                for (int j = 0; j < columnas; j++)
+                    destino[j] = (T)(R)fila[j];
+            else
+                for (int j = 0; j < columnas; j++)
+                    destino[j] = (T)(R)fila[j * pasoColumna];
+            for (int j = columnas; j < NT; j++)
+                destino[j] = 0;
+            destino += NT;
+        }
+    }
+}
+
+// Micro-núcleo MR×NT en C++ portable: con las filas desenrolladas los
+// acumuladores quedan en registros y cada fila se vectoriza con el ancho
+// disponible (con AVX-512 iguala al núcleo AVX2 de double y lo duplica en float)
+template <typename T>
+inline void microNucleoTipo(int kc, const T* a, const T* b, T* bloque) {
+    constexpr int NT = columnasNucleo<T>();
+    T acumulado[MR][NT] = {};
+    for (int p = 0; p < kc; p++) {
+        desenrollar<MR>([&](auto i) {
+            for (int j = 0; j < NT; j++)
+                acumulado[i][j] += a[i] * b[j];
+        });
+        a += MR;
+        b += NT;
+    }
+    for (int i = 0; i < MR; i++)
+        for (int j = 0; j < NT; j++)
+            bloque[i * NT + j] = acumulado[i][j];
+}
+
+// C (m×n) += alfa * A (m×k) * B (k×n) por bloques empaquetados, calculando
+// en T. A, B y C pueden ser de otro tipo: A y B se convierten al empaquetar
+// (redondeados a R, por defecto T) y cada bloque (hasta KC productos
+// acumulados en T) se suma a C en el suyo.
+template <typename T, typename TA, typename TB, typename TC, typename R = T>
+void multiplicarBloquesTipo(int m, int n, int k, const TA* a, ptrdiff_t filaA, ptrdiff_t columnaA,
+                            const TB* b, ptrdiff_t filaB, ptrdiff_t columnaB, TC* c, size_t pasoC,
+                            T alfa) {
+    constexpr int NT = columnasNucleo<T>();
+    static thread_local vector<T> panelA, panelB;
+    panelA.resize((size_t)MC * KC);
+    panelB.resize((size_t)KC * ((NC + NT - 1) / NT * NT));
+    T bloque[MR * NT];
+
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = min(NC, n - jc);
+        for (int pc = 0; pc < k; pc += KC) {
+            int kc = min(KC, k - pc);
+            empaquetarBTipo<T, R>(kc, nc, b + pc * filaB + jc * columnaB, filaB, columnaB, panelB.data());
+            for (int ic = 0; ic < m; ic += MC) {
+                int mc = min(MC, m - ic);
+                empaquetarATipo<T, R>(mc, kc, a + ic * filaA + pc * columnaA, filaA, columnaA, alfa,
+                                panelA.data());
+                for (int jr = 0; jr < nc; jr += NT) {
+                    int columnas = min(NT, nc - jr);
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        microNucleoTipo(kc, panelA.data() + (size_t)ir * kc,
+                                        panelB.data() + (size_t)jr * kc, bloque);
+                        TC* destino = c + (size_t)(ic + ir) * pasoC + jc + jr;
+                        for (int i = 0; i < min(MR, mc - ir); i++)
+                            for (int j = 0; j < columnas; j++)
+                                destino[i * pasoC + j] += (TC)bloque[i * NT + j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Igual que multiplicarParalelo: teselas TM×TN de C repartidas entre los
+// hilos, y los productos pequeños directo (acumulando en el tipo de C)
+template <typename T, typename TA, typename TB, typename TC, typename R = T>
+void multiplicarParaleloTipo(int m, int n, int k, const TA* a, ptrdiff_t filaA, ptrdiff_t columnaA,
+                             const TB* b, ptrdiff_t filaB, ptrdiff_t columnaB, TC* c, size_t pasoC,
+                             T alfa = 1) {
+    long long volumen = (long long)m * n * k;
+    if (volumen <= UMBRAL_BLOQUES) {
+        for (int i = 0; i < m; i++)
+            for (int p = 0; p < k; p++) {
+                T aip = alfa * (T)(R)a[i * filaA + p * columnaA];
+                const TB* origenB = b + p * filaB;
+                TC* filaC = c + (size_t)i * pasoC;
+                for (int j = 0; j < n; j++)
+                    filaC[j] += (TC)(aip * (T)(R)origenB[j * columnaB]);
+            }
+        return;
+    }
+
+    long long filasTeselas = (m + TM - 1) / TM;
+    long long columnasTeselas = (n + TN - 1) / TN;
+    if (getHilos() <= 1 || volumen < UMBRAL_PARALELO || filasTeselas * columnasTeselas < 2) {
+        multiplicarBloquesTipo<T, TA, TB, TC, R>(m, n, k, a, filaA, columnaA, b, filaB, columnaB, c,
+                                                 pasoC, alfa);
+        return;
+    }
+    grupo().paraCada(filasTeselas * columnasTeselas, [&](long long t) {
+        int i0 = (int)(t / columnasTeselas) * TM;
+        int j0 = (int)(t % columnasTeselas) * TN;
+        multiplicarBloquesTipo<T, TA, TB, TC, R>(min(TM, m - i0), min(TN, n - j0), k, a + i0 * filaA, filaA, columnaA,
+                               b + j0 * columnaB, filaB, columnaB, c + (size_t)i0 * pasoC + j0, pasoC,
+                               alfa);
+    });
+}
+
+}  // namespace gemm
+
+// Matriz densa de elementos T (float o double), sin las operaciones de
+// Matriz: se convierte desde y hacia ella y ofrece producto y LU
+// (DescomposicionLUGenerica). El formato de los datos es el mismo.
+template <typename T>
+class MatrizDensa {
+public:
+    static constexpr int ELEMENTOS_LINEA = Matriz::ALINEACION / sizeof(T);
+
+private:
+    int filas;
+    int columnas;
+    int paso;
+    T* datos;
+    string nombre;
+
+    void reservarMemoria() {
+        paso = (columnas + ELEMENTOS_LINEA - 1) / ELEMENTOS_LINEA * ELEMENTOS_LINEA;
+        datos = static_cast<T*>(PoolMatrices::global().reservar(bytes()));
+        if (paso > columnas)
+            for (int i = 0; i < filas; i++)
+                memset(fila(i) + columnas, 0, (paso - columnas) * sizeof(T));
+    }
+
+    void liberarMemoria() {
+        if (datos != nullptr)
+            PoolMatrices::global().liberar(datos, bytes());
+        datos = nullptr;
+    }
+
+    size_t bytes() const { return (size_t)filas * paso * sizeof(T); }
+
+public:
+    MatrizDensa(int filas, int columnas, bool inicializar, string nombre = "M")
+        : filas(filas), columnas(columnas), datos(nullptr), nombre(nombre) {
+        if (filas <= 0 || columnas <= 0) {
+            cerr << "Error: El tamaño de la matriz debe ser positivo.\n";
+            this->filas = 1;
+            this->columnas = 1;
+        }
+        reservarMemoria();
+        if (inicializar)
+            memset(datos, 0, bytes());
+    }
+
+    // Convierte una Matriz o vista de double (redondeando si T es float)
+    explicit MatrizDensa(const VistaMatriz& vista)
+        : MatrizDensa(vista.getFilas(), vista.getColumnas(), false, vista.getNombre()) {
+        for (int i = 0; i < filas; i++) {
+            const double* origen = vista.getDatos() + i * vista.getPasoFila();
+            for (int j = 0; j < columnas; j++)
+                fila(i)[j] = (T)origen[j * vista.getPasoColumna()];
+        }
+    }
+
+    // Cambia el tipo de los elementos
+    template <typename U>
+    explicit MatrizDensa(const MatrizDensa<U>& otra)
+        : MatrizDensa(otra.getFilas(), otra.getColumnas(), false, otra.getNombre()) {
+        for (int i = 0; i < filas; i++)
+            for (int j = 0; j < columnas; j++)
+                fila(i)[j] = (T)otra.fila(i)[j];
+    }
+
+    MatrizDensa(const MatrizDensa& otra) : MatrizDensa(otra.filas, otra.columnas, false, otra.nombre) {
+        memcpy(datos, otra.datos, bytes());
+    }
+
+    MatrizDensa(MatrizDensa&& otra) noexcept
+        : filas(otra.filas), columnas(otra.columnas), paso(otra.paso), datos(otra.datos),
+          nombre(move(otra.nombre)) {
+        otra.filas = otra.columnas = otra.paso = 0;
+        otra.datos = nullptr;
+    }
+
+    MatrizDensa& operator=(MatrizDensa otra) {
+        swap(filas, otra.filas);
+        swap(columnas, otra.columnas);
+        swap(paso, otra.paso);
+        swap(datos, otra.datos);
+        swap(nombre, otra.nombre);
+        return *this;
+    }
+
+    ~MatrizDensa() { liberarMemoria(); }
+
+    int getFilas() const { return filas; }
+    int getColumnas() const { return columnas; }
+    int getPaso() const { return paso; }
+    T* getDatos() { return datos; }
+    const T* getDatos() const { return datos; }
+    T* fila(int i) { return datos + (size_t)i * paso; }
+    const T* fila(int i) const { return datos + (size_t)i * paso; }
+    string getNombre() const { return nombre; }
+    void setNombre(string nuevoNombre) { nombre = nuevoNombre; }
+
+    Matriz aMatriz() const {
+        Matriz m(filas, columnas, false, nombre);
+        for (int i = 0; i < filas; i++)
+            for (int j = 0; j < columnas; j++)
+                m.fila(i)[j] = (double)fila(i)[j];
+        return m;
+    }
+
+    // Producto calculado y acumulado en T
+    MatrizDensa multiplicar(const MatrizDensa& otra) const {
+        if (columnas != otra.filas) {
+            cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+            return MatrizDensa(1, 1, true, "Error");
+        }
+        MatrizDensa resultado(filas, otra.columnas, true, nombre + "×" + otra.nombre);
+        gemm::multiplicarParaleloTipo(filas, otra.columnas, columnas, datos, paso, 1, otra.datos,
+                                      otra.paso, 1, resultado.datos, resultado.paso, (T)1);
+        return resultado;
+    }
+
+    void imprimir(int precision = 2) const { aMatriz().imprimir(precision); }
+};
+
+using MatrizSimple = MatrizDensa<float>;
+
+// A·B en precisión mixta: los datos de A y B se toman en float (redondeados
+// si vienen en double) y el micro-núcleo multiplica y acumula en double. El
+// producto de dos float es exacto en double, así que el error viene solo del
+// redondeo de los datos y no crece con k como al acumular en float; el costo
+// es el del producto en double.
+template <typename TA, typename TB>
+inline Matriz multiplicarMixto(int m, int n, int k, const TA* a, ptrdiff_t filaA, ptrdiff_t columnaA,
+                               const TB* b, ptrdiff_t filaB, ptrdiff_t columnaB, const string& nombre) {
+    Matriz resultado(m, n, true, nombre);
+    gemm::multiplicarParaleloTipo<double, TA, TB, double, float>(
+        m, n, k, a, filaA, columnaA, b, filaB, columnaB, resultado.getDatos(), resultado.getPaso(), 1.0);
+    return resultado;
+}
+
+inline Matriz multiplicarMixto(const VistaMatriz& a, const VistaMatriz& b) {
+    if (a.getColumnas() != b.getFilas()) {
+        cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+        return Matriz(1, 1, true, "Error");
+    }
+    return multiplicarMixto(a.getFilas(), b.getColumnas(), a.getColumnas(), a.getDatos(),
+                            a.getPasoFila(), a.getPasoColumna(), b.getDatos(), b.getPasoFila(),
+                            b.getPasoColumna(), a.getNombre() + "×" + b.getNombre());
+}
+
+inline Matriz multiplicarMixto(const MatrizSimple& a, const MatrizSimple& b) {
+    if (a.getColumnas() != b.getFilas()) {
+        cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
+        return Matriz(1, 1, true, "Error");
+    }
+    return multiplicarMixto(a.getFilas(), b.getColumnas(), a.getColumnas(), a.getDatos(), a.getPaso(),
+                            1, b.getDatos(), b.getPaso(), 1, a.getNombre() + "×" + b.getNombre());
+}
+
+//  DESCOMPOSICION LU
+// P A = L U con pivoteo parcial, por bloques y "right-looking": para cada
+// franja de BLOQUE columnas se factoriza el panel elemento a elemento
+// (intercambiando filas completas), se resuelve el bloque U12 a su derecha
+// y el resto de la matriz se actualiza con A22 -= L21 * U12 usando el
+// núcleo por bloques en paralelo. Ese producto concentra casi todas las
+// 2n^3/3 operaciones, así que la factorización corre a velocidad de gemm.
+// M es el tipo de la matriz factorizada: Matriz (DescomposicionLU) o
+// MatrizDensa<float> (DescomposicionLUSimple, para el refinamiento iterativo).
+template <typename M>
+class DescomposicionLUGenerica {
+public:
+    using Elemento = remove_cv_t<remove_pointer_t<decltype(declval<M&>().fila(0))>>;
+
+    static constexpr int BLOQUE = 128;   // Ancho de los paneles
+    static constexpr int HOJA = 8;       // Ancho en que el panel se elimina columna a columna
+
+private:
+    M lu;                    // L (sin su diagonal de unos) debajo y U encima
+    vector<int> pivotes;     // En el paso j se intercambiaron las filas j y pivotes[j]
+    int signo;               // (-1)^intercambios, para el determinante
+    bool cuadrada;           // Si no, ya se informó el error al construir
+    bool singular;
+    string nombre;
+
+    // Elimina las columnas [j0, j0 + nb) en las filas j0 en adelante,
+    // columna a columna. Solo se usa con paneles angostos (HOJA columnas),
+    // que caben en una línea de caché por fila.
+    void factorizarHoja(int j0, int nb) {
+        int n = lu.getFilas();
+        for (int j = j0; j < j0 + nb; j++) {
+            int p = j;
+            Elemento maximo = fabs(lu.fila(j)[j]);
+            for (int i = j + 1; i < n; i++)
+                if (fabs(lu.fila(i)[j]) > maximo) {
+                    maximo = fabs(lu.fila(i)[j]);
+                    p = i;
+                }
+            pivotes[j] = p;
+            if (maximo == 0) {
+                // Columna ya eliminada: no hay nada que dividir, pero U es singular
+                singular = true;
+                continue;
+            }
+            if (p != j) {
+                swap_ranges(lu.fila(j), lu.fila(j) + n, lu.fila(p));
+                signo = -signo;
+            }
+
+            const Elemento* filaPivote = lu.fila(j);
+            Elemento inverso = 1 / filaPivote[j];
+            for (int i = j + 1; i < n; i++) {
+                Elemento* fila = lu.fila(i);
+                Elemento l = fila[j] *= inverso;
+                for (int c = j + 1; c < j0 + nb; c++)
+                    fila[c] -= l * filaPivote[c];
+            }
+        }
+    }
+
+    // C (m×n) -= A (m×k) * B (k×n), con el núcleo de double de Matriz o el
+    // genérico en el tipo de los elementos
+    static void restarProducto(int m, int n, int k, const Elemento* a, int pasoA, const Elemento* b,
+                               int pasoB, Elemento* c, int pasoC) {
+        if constexpr (is_same<M, Matriz>::value)
+            gemm::multiplicarParalelo(VistaMatriz(a, m, k, pasoA, 1), VistaMatriz(b, k, n, pasoB, 1), c,
+                                      pasoC, -1.0);
+        else
+            gemm::multiplicarParaleloTipo(m, n, k, a, pasoA, 1, b, pasoB, 1, c, pasoC, (Elemento)-1);
+    }
+
+    // A[i0, i1) x [c0, c1) -= L[i0, i1) x [j0, j0 + nb) * U[j0, j0 + nb) x [c0, c1)
+    void actualizar(int j0, int nb, int i0, int i1, int c0, int c1) {
+        restarProducto(i1 - i0, c1 - c0, nb, lu.fila(i0) + j0, lu.getPaso(), lu.fila(j0) + c0,
+                       lu.getPaso(), lu.fila(i0) + c0, lu.getPaso());
+    }
+
+    // U12 = L11^-1 * A12 en las filas [j0, j0 + nb) y las columnas [c0, c1).
+    // También por mitades: resuelve la de arriba, la resta de la de abajo
+    // con un producto y resuelve la de abajo. Las hojas reparten las
+    // columnas entre hilos (son independientes).
+    void resolverBloqueU(int j0, int nb, int c0, int c1) {
+        if (nb > HOJA) {
+            int mitad = max(HOJA, nb / 2 / HOJA * HOJA);
+            resolverBloqueU(j0, mitad, c0, c1);
+            actualizar(j0, mitad, j0 + mitad, j0 + nb, c0, c1);
+            resolverBloqueU(j0 + mitad, nb - mitad, c0, c1);
+            return;
+        }
+        blas::repartirFilas(c1 - c0, (long long)nb * nb * (c1 - c0) / 2, [&](int inicio, int fin) {
+            for (int i = j0 + 1; i < j0 + nb; i++) {
+                Elemento* fila = lu.fila(i);
+                for (int p = j0; p < i; p++) {
+                    Elemento l = fila[p];
+                    const Elemento* filaP = lu.fila(p);
+                    for (int c = c0 + inicio; c < c0 + fin; c++)
+                        fila[c] -= l * filaP[c];
+                }
+            }
+        });
+    }
+
+    // Factoriza el panel [j0, j0 + nb) partiéndolo en mitades: la izquierda
+    // se factoriza, actualiza la derecha con un producto y luego se
+    // factoriza la derecha. Así casi todo el panel también va por gemm y no
+    // se recorre entero una vez por columna.
+    void factorizarPanel(int j0, int nb) {
+        if (nb <= HOJA) {
+            factorizarHoja(j0, nb);
+            return;
+        }
+        int mitad = max(HOJA, nb / 2 / HOJA * HOJA);
+        factorizarPanel(j0, mitad);
+        resolverBloqueU(j0, mitad, j0 + mitad, j0 + nb);
+        actualizar(j0, mitad, j0 + mitad, lu.getFilas(), j0 + mitad, j0 + nb);
+        factorizarPanel(j0 + mitad, nb - mitad);
+    }
+
+public:
+    explicit DescomposicionLUGenerica(const VistaMatriz& a)
+        : lu(a), pivotes(a.getFilas()), signo(1), cuadrada(a.getFilas() == a.getColumnas()),
+          singular(false), nombre(a.getNombre()) {
+        if (!cuadrada) {
+            cerr << "Error: La descomposición LU requiere una matriz cuadrada.\n";
+            lu = M(1, 1, true, "Error");
+            pivotes.assign(1, 0);
+            singular = true;
+            return;
+        }
+
+        int n = lu.getFilas();
+        for (int j0 = 0; j0 < n; j0 += BLOQUE) {
+            int nb = min(BLOQUE, n - j0);
+            factorizarPanel(j0, nb);
+            if (j0 + nb < n) {
+                resolverBloqueU(j0, nb, j0 + nb, n);
+                actualizar(j0, nb, j0 + nb, n, j0 + nb, n);
+            }
+        }
+    }
+
+    bool esSingular() const { return singular; }
+    int getOrden() const { return lu.getFilas(); }
+    const M& getLU() const { return lu; }
+    const vector<int>& getPivotes() const { return pivotes; }
+
+    // det(A) = (-1)^intercambios * producto de la diagonal de U. Con n de
+    // cientos el producto puede desbordar a inf o quedar en 0 aunque A no
+    // sea singular; esSingular() es la prueba fiable.
+    double determinante() const {
+        if (singular)
+            return 0.0;
+        double producto = signo;
+        for (int i = 0; i < lu.getFilas(); i++)
+            producto *= lu.fila(i)[i];
+        return producto;
+    }
+
+    // Sobrescribe B (n filas, tantas columnas como lados derechos) con la
+    // solución X de A X = B. Las sustituciones también van por bloques: cada
+    // bloque diagonal se resuelve fila a fila y el resto se actualiza con gemm.
+    bool resolverEnSitio(M& x) const {
+        int n = lu.getFilas(), m = x.getColumnas();
+        if (!cuadrada)
+            return false;
+        if (x.getFilas() != n) {
+            cerr << "Error: B debe tener tantas filas como la matriz.\n";
+            return false;
+        }
+        if (singular) {
+            cerr << "Error: La matriz es singular.\n";
+            return false;
+        }
+
+        for (int j = 0; j < n; j++)
+            if (pivotes[j] != j)
+                swap_ranges(x.fila(j), x.fila(j) + m, x.fila(pivotes[j]));
+
+        // L Y = P B, de arriba hacia abajo
+        for (int k0 = 0; k0 < n; k0 += BLOQUE) {
+            int nb = min(BLOQUE, n - k0);
+            for (int i = k0 + 1; i < k0 + nb; i++)
+                for (int p = k0; p < i; p++) {
+                    Elemento l = lu.fila(i)[p];
+                    for (int c = 0; c < m; c++)
+                        x.fila(i)[c] -= l * x.fila(p)[c];
+                }
+            if (k0 + nb < n)
+                restarProducto(n - k0 - nb, m, nb, lu.fila(k0 + nb) + k0, lu.getPaso(), x.fila(k0),
+                               x.getPaso(), x.fila(k0 + nb), x.getPaso());
+        }
+
+        // U X = Y, de abajo hacia arriba
+        for (int k0 = (n - 1) / BLOQUE * BLOQUE; k0 >= 0; k0 -= BLOQUE) {
+            int nb = min(BLOQUE, n - k0);
+            for (int i = k0 + nb - 1; i >= k0; i--) {
+                for (int p = i + 1; p < k0 + nb; p++) {
+                    Elemento u = lu.fila(i)[p];
+                    for (int c = 0; c < m; c++)
+                        x.fila(i)[c] -= u * x.fila(p)[c];
+                }
+                Elemento inverso = 1 / lu.fila(i)[i];
+                for (int c = 0; c < m; c++)
+                    x.fila(i)[c] *= inverso;
+            }
+            if (k0 > 0)
+                restarProducto(k0, m, nb, lu.fila(0) + k0, lu.getPaso(), x.fila(k0), x.getPaso(),
+                               x.fila(0), x.getPaso());
+        }
+        return true;
+    }
+
+    // X = A^-1 B para todos los lados derechos (columnas de B) a la vez
+    M resolver(const VistaMatriz& b) const {
+        M x(b);
+        x.setNombre(nombre + "\\" + b.getNombre());
+        if (!resolverEnSitio(x))
+            return M(1, 1, true, "Error");
+        return x;
+    }
+
+    // Un solo lado derecho: sustituciones con productos punto por filas
+    vector<double> resolver(const vector<double>& b) const {
+        int n = lu.getFilas();
+        if ((int)b.size() != n || singular) {
+            if (cuadrada)
+                cerr << (singular ? "Error: La matriz es singular.\n"
+                                  : "Error: b debe tener tantos elementos como filas la matriz.\n");
+            return vector<double>(n, 0.0);
+        }
+        vector<double> x(b);
+        for (int j = 0; j < n; j++)
+            swap(x[j], x[pivotes[j]]);
+        auto productoPunto = [](int largo, const Elemento* fila, const double* v) {
+            if constexpr (is_same<Elemento, double>::value) {
+                return blas::productoPunto(largo, fila, v);
+            } else {
+                double suma = 0.0;
+                for (int k = 0; k < largo; k++)
+                    suma += fila[k] * v[k];
+                return suma;
+            }
+        };
+        for (int i = 1; i < n; i++)
+            x[i] -= productoPunto(i, lu.fila(i), x.data());
+        for (int i = n - 1; i >= 0; i--)
+            x[i] = (x[i] - productoPunto(n - 1 - i, lu.fila(i) + i + 1, x.data() + i + 1)) /
+                   lu.fila(i)[i];
+        return x;
+    }
+
+    // A^-1 = A^-1 I, resolviendo los n lados derechos de la identidad
+    M inversa() const {
+        int n = lu.getFilas();
+        M x(n, n, true, nombre + "^-1");
+        for (int i = 0; i < n; i++)
+            x.fila(i)[i] = 1;
+        if (!resolverEnSitio(x))
+            return M(1, 1, true, "Error");
+        return x;
+    }
+};
+
+using DescomposicionLU = DescomposicionLUGenerica<Matriz>;
+using DescomposicionLUSimple = DescomposicionLUGenerica<MatrizSimple>;
+
+inline Matriz Matriz::resolver(const VistaMatriz& b) const {
+    return DescomposicionLU(vista()).resolver(b);
+}
+
+inline double Matriz::determinante() const {
+    if (filas != columnas) {
+        cerr << "Error: El determinante requiere una matriz cuadrada.\n";
+        return 0.0;
+    }
+    return DescomposicionLU(vista()).determinante();
+}
+
+inline Matriz Matriz::inversa() const {
+    return DescomposicionLU(vista()).inversa();
+}
+
+//  REFINAMIENTO ITERATIVO
+// A X = B con la exactitud de double a la velocidad de float: la
+// factorización (las 2n^3/3 operaciones) se hace en float y en cada paso se
+// calcula el residuo R = B - A X en double y se corrige X con la solución en
+// float de A D = R. Cada paso reduce el error en un factor cercano a
+// cond(A)·2^-24, así que basta con pocos pasos si cond(A) es bastante menor
+// que 10^7. Si el residuo deja de bajar se resuelve todo en double, como
+// hace LAPACK (dsgesv).
+
+struct EstadisticasRefinamiento {
+    int pasos = 0;              // Correcciones en float aplicadas
+    double residuo = 0.0;       // ||B - A X|| / (||A|| ||X|| + ||B||), norma infinito
+    bool convergio = false;     // Si no, la solución se calculó en double
+};
+
+const int MAX_PASOS_REFINAMIENTO = 30;
+
+// Máxima suma de valores absolutos de una fila
+inline double normaInfinito(const VistaMatriz& a) {
+    double maximo = 0.0;
+    for (int i = 0; i < a.getFilas(); i++) {
+        double suma = 0.0;
+        for (int j = 0; j < a.getColumnas(); j++)
+            suma += fabs(a(i, j));
+        maximo = max(maximo, suma);
+    }
+    return maximo;
+}
+
+// R = B - A X y su tamaño relativo
+inline double residuoRelativo(const VistaMatriz& a, const VistaMatriz& b, const Matriz& x, Matriz& r,
+                              double normaA, double normaB) {
+    r = Matriz(b);
+    blas::gemm(-1.0, a, x, 1.0, r);
+    double denominador = normaA * normaInfinito(x) + normaB;
+    return denominador > 0.0 ? normaInfinito(r) / denominador : 0.0;
+}
+
+inline Matriz resolverRefinado(const VistaMatriz& a, const VistaMatriz& b,
+                               EstadisticasRefinamiento* estadisticas = nullptr) {
+    int n = a.getFilas();
+    if (n != a.getColumnas() || b.getFilas() != n) {
+        cerr << "Error: A debe ser cuadrada y B tener tantas filas como A.\n";
+        return Matriz(1, 1, true, "Error");
+    }
+
+    EstadisticasRefinamiento resultado;
+    double normaA = normaInfinito(a), normaB = normaInfinito(b);
+    double tolerancia = sqrt((double)n) * numeric_limits<double>::epsilon();
+    Matriz x(n, b.getColumnas(), true, a.getNombre() + "\\" + b.getNombre());
+    Matriz r(b);
+
+    DescomposicionLUSimple lu(a);
+    if (!lu.esSingular()) {
+        double error = normaB > 0.0 ? 1.0 : 0.0;   // Con X = 0, R = B
+        double anterior = INFINITY;
+        while (error > tolerancia && error < anterior / 2 && resultado.pasos < MAX_PASOS_REFINAMIENTO) {
+            MatrizSimple correccion(r);
+            lu.resolverEnSitio(correccion);
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < x.getColumnas(); j++)
+                    x.fila(i)[j] += correccion.fila(i)[j];
+            resultado.pasos++;
+            anterior = error;
+            error = residuoRelativo(a, b, x, r, normaA, normaB);
+        }
+        resultado.residuo = error;
+        resultado.convergio = error <= tolerancia;
+    }
+
+    if (!resultado.convergio) {
+        string nombre = x.getNombre();
+        x = DescomposicionLU(a).resolver(b);
+        if (x.getFilas() == n) {                // Si no, A es singular
+            x.setNombre(nombre);
+            resultado.residuo = residuoRelativo(a, b, x, r, normaA, normaB);
+        }
+    }
+    if (estadisticas != nullptr)
+        *estadisticas = resultado;
+    return x;
+}
+
+//  MATRICES DE TAMAÑO FIJO
+// Para muchas matrices pequeñas (3x3, 4x4, 6x6...) el costo de Matriz está
+// en la reserva, el nombre y la validación de índices, no en las cuentas.
+// MatrizFija guarda sus R×C elementos en la pila con el tamaño conocido al
+// compilar, así que los bucles se desenrollan por completo. Para procesar
+// lotes, LoteMatricesFijas guarda los elementos en "estructura de arreglos":
+// el elemento (i, j) de todas las matrices es contiguo y cada operación
+// vectoriza a lo ancho del lote (8 matrices por línea de caché con double).
+template <int R, int C, typename T = double>
+class MatrizFija {
+    static_assert(R > 0 && C > 0, "MatrizFija requiere dimensiones positivas");
+
+    T datos[R * C];          // Por filas, sin relleno
+
+    template <int, int, typename> friend class MatrizFija;
+
+    // Para resultados que se escriben completos: sin poner en cero
+    struct SinInicializar {};
+    explicit MatrizFija(SinInicializar) {}
+
+public:
+    MatrizFija() : datos{} {}
+
+    // Elementos por filas; los que falten quedan en cero
+    MatrizFija(initializer_list<T> valores) : datos{} {
+        int k = 0;
+        for (T valor : valores)
+            if (k < R * C)
+                datos[k++] = valor;
+    }
+
+    explicit MatrizFija(const VistaMatriz& vista) : datos{} {
+        if (vista.getFilas() != R || vista.getColumnas() != C) {
+            cerr << "Error: La matriz no es de " << R << "x" << C << ".\n";
+            return;
+        }
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                datos[i * C + j] = (T)vista(i, j);
+    }
+
+    static MatrizFija identidad() {
+        static_assert(R == C, "La identidad debe ser cuadrada");
+        MatrizFija m;
+        for (int i = 0; i < R; i++)
+            m.datos[i * C + i] = 1;
+        return m;
+    }
+
+    static constexpr int getFilas() { return R; }
+    static constexpr int getColumnas() { return C; }
+
+    // Sin validación de índices: el tamaño lo comprueba el compilador
+    T* operator[](int i) { return datos + i * C; }
+    const T* operator[](int i) const { return datos + i * C; }
+    T* getDatos() { return datos; }
+    const T* getDatos() const { return datos; }
+
+    // Orden i-k-j con k y j desenrollados: la fila del resultado se acumula
+    // en registros y se escribe una sola vez
+    template <int K>
+    MatrizFija<R, K, T> operator*(const MatrizFija<C, K, T>& otra) const {
+        MatrizFija<R, K, T> resultado{typename MatrizFija<R, K, T>::SinInicializar{}};
+        for (int i = 0; i < R; i++) {
+            const T* filaA = datos + i * C;
+            T fila[K];
+            desenrollar<K>([&](auto j) { fila[j] = filaA[0] * otra[0][j]; });
+            desenrollar<C - 1>([&](auto k) {
+                desenrollar<K>([&](auto j) { fila[j] += filaA[k + 1] * otra[k + 1][j]; });
+            });
+            desenrollar<K>([&](auto j) { resultado[i][j] = fila[j]; });
+        }
+        return resultado;
+    }
+
+    MatrizFija operator+(const MatrizFija& otra) const {
+        MatrizFija resultado{SinInicializar{}};
+        for (int k = 0; k < R * C; k++)
+            resultado.datos[k] = datos[k] + otra.datos[k];
+        return resultado;
+    }
+
+    MatrizFija operator-(const MatrizFija& otra) const {
+        MatrizFija resultado{SinInicializar{}};
+        for (int k = 0; k < R * C; k++)
+            resultado.datos[k] = datos[k] - otra.datos[k];
+        return resultado;
+    }
+
+    MatrizFija operator*(T escalar) const {
+        MatrizFija resultado{SinInicializar{}};
+        for (int k = 0; k < R * C; k++)
+            resultado.datos[k] = datos[k] * escalar;
+        return resultado;
+    }
+
+    MatrizFija<C, R, T> transpuesta() const {
+        MatrizFija<C, R, T> resultado{typename MatrizFija<C, R, T>::SinInicializar{}};
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                resultado[j][i] = datos[i * C + j];
+        return resultado;
+    }
+
+    Matriz aMatriz(const string& nombre = "M") const {
+        Matriz m(R, C, false, nombre);
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                m.fila(i)[j] = (double)datos[i * C + j];
+        return m;
+    }
+
+    void imprimir(const string& nombre = "M", int precision = 2) const {
+        aMatriz(nombre).imprimir(precision);
+    }
+};
+
+// Lote de "cantidad" matrices R×C en estructura de arreglos por grupos: cada
+// grupo de CARRIL matrices guarda juntos sus R×C componentes, y cada
+// componente son los CARRIL valores de ese elemento (una línea de caché). El
+// elemento (i, j) de la matriz m está en grupo(m / CARRIL)[(i*C + j)*CARRIL
+// + m % CARRIL], y el relleno del último grupo vale cero. Con un arreglo por
+// componente (SoA puro) el producto recorría R·C flujos separados que
+// además caían en el mismo conjunto de la caché L1 cuando su separación era
+// múltiplo de 4 KB; por grupos se recorre la memoria en orden.
+template <int R, int C, typename T = double>
+class LoteMatricesFijas {
+public:
+    static constexpr int CARRIL = 64 / sizeof(T);   // Matrices por línea de caché
+    static constexpr int ELEMENTOS_GRUPO = R * C * CARRIL;
+
+private:
+    size_t cantidad;
+    size_t grupos;
+    T* datos;
+
+    size_t bytes() const { return grupos * ELEMENTOS_GRUPO * sizeof(T); }
+
+    void reservar() {
+        grupos = (cantidad + CARRIL - 1) / CARRIL;
+        datos = grupos ? static_cast<T*>(PoolMatrices::global().reservar(bytes())) : nullptr;
+    }
+
+    void liberar() {
+        if (datos != nullptr)
+            PoolMatrices::global().liberar(datos, bytes());
+        datos = nullptr;
+    }
+
+    static size_t indice(size_t m, int i, int j) {
+        return (m / CARRIL) * ELEMENTOS_GRUPO + (i * C + j) * CARRIL + m % CARRIL;
+    }
+
+public:
+    explicit LoteMatricesFijas(size_t cantidad = 0) : cantidad(cantidad) {
+        reservar();
+        if (datos != nullptr)
+            memset(datos, 0, bytes());
+    }
+
+    LoteMatricesFijas(const LoteMatricesFijas& otro) : cantidad(otro.cantidad) {
+        reservar();
+        if (datos != nullptr)
+            memcpy(datos, otro.datos, bytes());
+    }
+
+    LoteMatricesFijas(LoteMatricesFijas&& otro) noexcept
+        : cantidad(otro.cantidad), grupos(otro.grupos), datos(otro.datos) {
+        otro.cantidad = otro.grupos = 0;
+        otro.datos = nullptr;
+    }
+
+    LoteMatricesFijas& operator=(LoteMatricesFijas otro) {
+        swap(cantidad, otro.cantidad);
+        swap(grupos, otro.grupos);
+        swap(datos, otro.datos);
+        return *this;
+    }
+
+    ~LoteMatricesFijas() { liberar(); }
+
+    size_t tamano() const { return cantidad; }
+    size_t getGrupos() const { return grupos; }
+
+    T* grupo(size_t g) { return datos + g * ELEMENTOS_GRUPO; }
+    const T* grupo(size_t g) const { return datos + g * ELEMENTOS_GRUPO; }
+
+    MatrizFija<R, C, T> obtener(size_t m) const {
+        MatrizFija<R, C, T> resultado;
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                resultado[i][j] = datos[indice(m, i, j)];
+        return resultado;
+    }
+
+    void asignar(size_t m, const MatrizFija<R, C, T>& valor) {
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                datos[indice(m, i, j)] = valor[i][j];
+    }
+};
+
+// C[m] = A[m] · B[m] para todo el lote. Para cada fila i se acumulan los C
+// elementos de un registro de productos a la vez (BYTES_VECTOR: con SSE2 un
+// grupo de 64 bytes se recorre en cuatro pasadas para no agotar los 16
+// registros), con k y j desenrollados: cada componente de A se carga una
+// vez por fila. Los grupos se reparten entre los hilos cuando el lote es
+// grande. C no puede ser A ni B.
+template <int R, int K, int C, typename T>
+void multiplicarLote(const LoteMatricesFijas<R, K, T>& a, const LoteMatricesFijas<K, C, T>& b,
+                     LoteMatricesFijas<R, C, T>& c) {
+    if (a.tamano() != b.tamano() || a.tamano() != c.tamano()) {
+        cerr << "Error: Los lotes deben tener la misma cantidad de matrices.\n";
+        return;
+    }
+    if ((const void*)&c == (const void*)&a || (const void*)&c == (const void*)&b) {
+        cerr << "Error: El resultado no puede ser uno de los factores.\n";
+        return;
+    }
+
+    constexpr int L = LoteMatricesFijas<R, C, T>::CARRIL;
+    constexpr int V = BYTES_VECTOR / sizeof(T);      // Productos por registro
+    int grupos = (int)a.getGrupos();
+    blas::repartirFilas(grupos, (long long)grupos * L * R * C * K, [&](int inicio, int fin) {
+        for (int g = inicio; g < fin; g++) {
+            for (int v = 0; v < L; v += V) {
+                const T* grupoA = a.grupo(g) + v;
+                const T* grupoB = b.grupo(g) + v;
+                T* grupoC = c.grupo(g) + v;
+                for (int i = 0; i < R; i++) {
+                    const T* filaA = grupoA + i * K * L;
+                    T suma[C][V];
+                    desenrollar<C>([&](auto j) {
+                        for (int l = 0; l < V; l++)
+                            suma[j][l] = filaA[l] * grupoB[j * L + l];
+                    });
+                    desenrollar<K - 1>([&](auto k) {
+                        const T* elementoA = filaA + (k + 1) * L;
+                        const T* filaB = grupoB + (k + 1) * C * L;
+                        desenrollar<C>([&](auto j) {
+                            for (int l = 0; l < V; l++)
+                                suma[j][l] += elementoA[l] * filaB[j * L + l];
+                        });
+                    });
+                    T* filaC = grupoC + i * C * L;
+                    desenrollar<C>([&](auto j) {
+                        for (int l = 0; l < V; l++)
+                            filaC[j * L + l] = suma[j][l];
+                    });
+                }
+            }
+        }
+    });
+}
+
+//  REGISTRO DE MATRICES
+// Almacén de las matrices de una sesión. Cada matriz se identifica con un
+// manejador (posición + generación) que sigue siendo válido aunque se
+// borren otras matrices; uno de una matriz ya borrada se detecta en vez de
+// apuntar a la que ocupe su lugar. Los nombres son únicos y se buscan en
+// O(1). Las matrices viven dentro del registro (sin new/delete por matriz)
+// y sus bloques de datos salen del pool.
+class RegistroMatrices {
+public:
+    struct Manejador {
+        uint32_t indice = UINT32_MAX;
+        uint32_t generacion = 0;
+        bool esValido() const { return indice != UINT32_MAX; }
+    };
+
+private:
+    struct Ranura {
+        optional<Matriz> matriz;
+        uint32_t generacion = 0;
+    };
+
+    deque<Ranura> ranuras;                       // No se mueven al crecer
+    vector<uint32_t> ranurasLibres;              // Vacías, para reutilizar
+    vector<uint32_t> orden;                      // Índices en orden de inserción
+    unordered_map<string, uint32_t> porNombre;
+
+    // El nombre pedido, o con un sufijo _2, _3, ... si ya está en uso
+    string nombreLibre(const string& nombre) const {
+        if (porNombre.find(nombre) == porNombre.end())
+            return nombre;
+        for (int sufijo = 2;; sufijo++) {
+            string candidato = nombre + "_" + to_string(sufijo);
+            if (porNombre.find(candidato) == porNombre.end())
+                return candidato;
+        }
+    }
+
+public:
+    // Guarda la matriz y devuelve su manejador; si el nombre ya existe se le
+    // agrega un sufijo (getNombre() devuelve el definitivo)
+    Manejador agregar(Matriz&& m) {
+        uint32_t indice;
+        if (!ranurasLibres.empty()) {
+            indice = ranurasLibres.back();
+            ranurasLibres.pop_back();
+        } else {
+            indice = (uint32_t)ranuras.size();
+            ranuras.emplace_back();
+        }
+        Ranura& ranura = ranuras[indice];
+        m.setNombre(nombreLibre(m.getNombre()));
+        ranura.matriz.emplace(move(m));
+        porNombre[ranura.matriz->getNombre()] = indice;
+        orden.push_back(indice);
+        return {indice, ranura.generacion};
+    }
+
+    Manejador agregar(const Matriz& m) { return agregar(Matriz(m)); }
+
+    // nullptr si el manejador no es válido o su matriz ya se borró. El
+    // nombre se cambia con renombrar(), no con setNombre().
+    Matriz* obtener(Manejador h) {
+        if (h.indice >= ranuras.size() || ranuras[h.indice].generacion != h.generacion ||
+            !ranuras[h.indice].matriz)
+            return nullptr;
+        return &*ranuras[h.indice].matriz;
+    }
+
+    const Matriz* obtener(Manejador h) const {
+        return const_cast<RegistroMatrices*>(this)->obtener(h);
+    }
+
+    Manejador buscar(const string& nombre) const {
+        auto encontrado = porNombre.find(nombre);
+        if (encontrado == porNombre.end())
+            return {};
+        return {encontrado->second, ranuras[encontrado->second].generacion};
+    }
+
+    // La posición-ésima matriz en orden de inserción (0 = la más antigua)
+    Manejador manejadorEn(size_t posicion) const {
+        if (posicion >= orden.size())
+            return {};
+        return {orden[posicion], ranuras[orden[posicion]].generacion};
+    }
+
+    bool eliminar(Manejador h) {
+        Matriz* m = obtener(h);
+        if (m == nullptr)
+            return false;
+        porNombre.erase(m->getNombre());
+        orden.erase(find(orden.begin(), orden.end(), h.indice));
+        ranuras[h.indice].matriz.reset();        // El bloque vuelve al pool
+        ranuras[h.indice].generacion++;
+        ranurasLibres.push_back(h.indice);
+        return true;
+    }
+
+    bool renombrar(Manejador h, const string& nuevo) {
+        Matriz* m = obtener(h);
+        if (m == nullptr || porNombre.count(nuevo) != 0)
+            return false;
+        porNombre.erase(m->getNombre());
+        m->setNombre(nuevo);
+        porNombre[nuevo] = h.indice;
+        return true;
+    }
+
+    void vaciar() {
+        while (!orden.empty())
+            eliminar(manejadorEn(orden.size() - 1));
+    }
+
+    size_t tamano() const { return orden.size(); }
+    bool vacio() const { return orden.empty(); }
+};
+
+//  FUNCIONES AUXILIARES
+void mostrarMatricesAlmacenadas(const RegistroMatrices& registro) {
+    if (registro.vacio()) {
+        cout << "No hay matrices almacenadas.\n";
+        return;
+    }
+
+    cout << "\n=== MATRICES ALMACENADAS ===\n";
+    for (size_t i = 0; i < registro.tamano(); i++) {
+        const Matriz* m = registro.obtener(registro.manejadorEn(i));
+        cout << i + 1 << ". " << m->getNombre()
+             << " (" << m->getFilas() << "x"
+             << m->getColumnas() << ")\n";
+    }
+    cout << endl;
+}
+
+// Acepta el número de la lista o el nombre de la matriz
+RegistroMatrices::Manejador seleccionarManejador(const RegistroMatrices& registro, const string& mensaje) {
+    if (registro.vacio()) {
+        cout << "No hay matrices almacenadas.\n";
+        return {};
+    }
+
+    mostrarMatricesAlmacenadas(registro);
+    string opcion;
+    cout << mensaje;
+    cin >> opcion;
+
+    RegistroMatrices::Manejador h = registro.buscar(opcion);
+    if (!h.esValido() && !opcion.empty() && opcion.size() < 10 &&
+        all_of(opcion.begin(), opcion.end(), [](char c) { return c >= '0' && c <= '9'; }) &&
+        stoi(opcion) >= 1)
+        h = registro.manejadorEn(stoi(opcion) - 1);
+    if (!h.esValido())
+        cout << "Opción inválida.\n";
+    return h;
+}
 
-        reservarMemoria();
+Matriz* seleccionarMatriz(RegistroMatrices& registro, const string& mensaje) {
+    return registro.obtener(seleccionarManejador(registro, mensaje));
+}
 
-        for (int i = 0; i < this->filas; i++) {
-            for (int j = 0; j < this->columnas; j++) {
-                datos[i][j] = min + (max - min) * (rand() % 100) / 99.0;
-            }
-        }
-    }
+//  PRUEBAS DE RENDIMIENTO
 
-    // Constructor que permite ingresar valores manualmente
-    Matriz(int filas, int columnas, string nombre = "M")
-        : filas(filas), columnas(columnas), datos(nullptr), nombre(nombre) {
+// Matriz original con una reserva por fila y sin movimiento.
+// Solo se conserva como referencia para las pruebas de rendimiento.
+struct MatrizFilas {
+    static inline long long reservas = 0;
 
-        if (filas <= 0 || columnas <= 0) {
-            cerr << "Error: El tamaño de la matriz debe ser positivo.\n";
-            this->filas = 1;
-            this->columnas = 1;
-        }
+    int filas, columnas;
+    double** datos;
+    string nombre;
 
-        reservarMemoria();
+    void reservarMemoria() {
+        datos = new double*[filas];
+        for (int i = 0; i < filas; i++)
+            datos[i] = new double[columnas];
+        reservas += filas + 1;
+    }
 
-        cout << "\nIngrese los elementos de la matriz " << nombre 
-             << " (" << filas << "x" << columnas << "):\n";
-        for (int i = 0; i < filas; i++) {
-            for (int j = 0; j < columnas; j++) {
-                cout << "  Elemento [" << i << "][" << j << "]: ";
-                cin >> datos[i][j];
-            }
-        }
+    void liberarMemoria() {
+        for (int i = 0; i < filas; i++)
+            delete[] datos[i];
+        delete[] datos;
     }
 
-    // Constructor de copia
-    Matriz(const Matriz& otra)
-        : filas(otra.filas), columnas(otra.columnas), datos(nullptr), nombre(otra.nombre) {
+    MatrizFilas(int filas, int columnas, string nombre)
+        : filas(filas), columnas(columnas), nombre(nombre) {
         reservarMemoria();
         for (int i = 0; i < filas; i++)
             for (int j = 0; j < columnas; j++)
-                datos[i][j] = otra.datos[i][j];
+                datos[i][j] = 0.0;
     }
 
-    // Constructor para matriz vacía o inicializada en ceros
-    Matriz(int filas, int columnas, bool inicializar, string nombre)
-        : filas(filas), columnas(columnas), datos(nullptr), nombre(nombre) {
+    explicit MatrizFilas(const Matriz& m)
+        : filas(m.getFilas()), columnas(m.getColumnas()), nombre(m.getNombre()) {
         reservarMemoria();
-        if (inicializar)
-            for (int i = 0; i < filas; i++)
-                for (int j = 0; j < columnas; j++)
-                    datos[i][j] = 0.0;
+        for (int i = 0; i < filas; i++)
+            for (int j = 0; j < columnas; j++)
+                datos[i][j] = m.getValor(i, j);
     }
 
-    // Destructor
-    ~Matriz() {
-        liberarMemoria();
+    MatrizFilas(const MatrizFilas& otra)
+        : filas(otra.filas), columnas(otra.columnas), nombre(otra.nombre) {
+        reservarMemoria();
+        for (int i = 0; i < filas; i++)
+            for (int j = 0; j < columnas; j++)
+                datos[i][j] = otra.datos[i][j];
     }
 
-    // Operador de asignación
-    Matriz& operator=(const Matriz& otra) {
+    ~MatrizFilas() { liberarMemoria(); }
+
+    MatrizFilas& operator=(const MatrizFilas& otra) {
         if (this != &otra) {
             liberarMemoria();
             filas = otra.filas;
             columnas = otra.columnas;
             nombre = otra.nombre;
             reservarMemoria();
-
             for (int i = 0; i < filas; i++)
                 for (int j = 0; j < columnas; j++)
                     datos[i][j] = otra.datos[i][j];
@@ -118,121 +3493,1026 @@ public:
         return *this;
     }
 
-    // Métodos de acceso
-    int getFilas() const { return filas; }
-    int getColumnas() const { return columnas; }
-    string getNombre() const { return nombre; }
-    void setNombre(string nuevoNombre) { nombre = nuevoNombre; }
+    MatrizFilas operator*(const MatrizFilas& otra) const {
+        MatrizFilas resultado(filas, otra.columnas, nombre + "×" + otra.nombre);
+        for (int i = 0; i < filas; i++)
+            for (int j = 0; j < otra.columnas; j++)
+                for (int k = 0; k < columnas; k++)
+                    resultado.datos[i][j] += datos[i][k] * otra.datos[k][j];
+        return resultado;
+    }
+};
 
-    // Operador [] para acceso por fila
-    double* operator[](int i) {
-        if (i < 0 || i >= filas) {
-            cerr << "Error: Índice fuera de rango.\n";
-            return datos[0];
+// Ejecuta la función dada y devuelve el tiempo transcurrido en segundos
+template <typename Funcion>
+double medirSegundos(Funcion funcion) {
+    auto inicio = chrono::steady_clock::now();
+    funcion();
+    auto fin = chrono::steady_clock::now();
+    return chrono::duration<double>(fin - inicio).count();
+}
+
+// Cadena R = R * M[k] con la matriz por filas (referencia) y con el bloque
+// contiguo; cuenta reservas y comprueba que ambos resultados coinciden
+void medirCadena(int n, int repeticiones) {
+    const int longitud = 8;
+    vector<Matriz> factores;
+    for (int k = 0; k < longitud; k++)
+        factores.push_back(Matriz(n, n, 0.0, 1.0, "F"));
+    vector<MatrizFilas> factoresFilas;
+    for (const Matriz& f : factores)
+        factoresFilas.push_back(MatrizFilas(f));
+
+    MatrizFilas resultadoFilas(1, 1, "R");
+    long long reservasFilas = MatrizFilas::reservas;
+    double tFilas = medirSegundos([&]() {
+        for (int r = 0; r < repeticiones; r++) {
+            resultadoFilas = factoresFilas[0];
+            for (int k = 1; k < longitud; k++)
+                resultadoFilas = resultadoFilas * factoresFilas[k];
+        }
+    });
+    reservasFilas = MatrizFilas::reservas - reservasFilas;
+
+    Matriz resultado(1, 1, true, "R");
+    long long reservasContiguas = Matriz::reservas;
+    double tContigua = medirSegundos([&]() {
+        for (int r = 0; r < repeticiones; r++) {
+            resultado = factores[0];
+            for (int k = 1; k < longitud; k++)
+                resultado = resultado * factores[k];
+        }
+    });
+    reservasContiguas = Matriz::reservas - reservasContiguas;
+
+    double diferencia = 0.0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            diferencia = max(diferencia, fabs(resultado.getValor(i, j) - resultadoFilas.datos[i][j]));
+
+    long long cadenas = repeticiones;
+    cout << "\n" << n << "x" << n << ", " << cadenas << " cadenas de " << longitud - 1 << " productos\n";
+    cout << "  Por filas (double**): " << setw(9) << tFilas * 1e3 << " ms   "
+         << setw(8) << (double)reservasFilas / cadenas << " reservas/cadena\n";
+    cout << "  Bloque contiguo:      " << setw(9) << tContigua * 1e3 << " ms   "
+         << setw(8) << (double)reservasContiguas / cadenas << " reservas/cadena\n";
+    cout << "  Diferencia maxima: " << scientific << diferencia << fixed << "\n";
+}
+
+void pruebaRendimientoAlmacenamiento() {
+    cout << fixed << setprecision(2);
+    medirCadena(4, 100000);
+    medirCadena(32, 2000);
+    medirCadena(200, 3);
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Rendimiento del micro-núcleo con los paneles en caché L1: es el techo
+// práctico de GFLOP/s de un núcleo de la CPU para este código
+double medirPicoNucleo() {
+    const int kc = 128;
+    const int repeticiones = 200000;
+    vector<double> a((size_t)gemm::MR * kc, 0.5), b((size_t)gemm::NR * kc, 0.25);
+    double bloque[gemm::MR * gemm::NR];
+    double suma = 0.0;
+    double t = medirSegundos([&]() {
+        for (int r = 0; r < repeticiones; r++) {
+            gemm::microNucleo(kc, a.data(), b.data(), bloque);
+            suma += bloque[r % (gemm::MR * gemm::NR)];
         }
-        return datos[i];
+    });
+    if (suma < 0)
+        cout << suma;
+    return 2.0 * gemm::MR * gemm::NR * kc * repeticiones / t / 1e9;
+}
+
+// Compara el producto por bloques con el triple bucle original. En los
+// tamaños grandes el bucle original es demasiado lento y se verifica una
+// muestra de elementos con productos punto directos.
+void pruebaRendimientoMultiplicacion() {
+    const int tamanos[] = {500, 1000, 2000, 4000};
+    const int maximoIngenuo = 1000;
+    double pico = medirPicoNucleo();
+    {
+        // Calentamiento: reserva los paneles empaquetados del hilo
+        Matriz calentamiento(256, 256, -1.0, 1.0, "W");
+        calentamiento = calentamiento * calentamiento;
     }
 
-    const double* operator[](int i) const {
-        if (i < 0 || i >= filas) {
-            cerr << "Error: Índice fuera de rango.\n";
-            return datos[0];
+    cout << fixed << setprecision(2);
+    cout << "\nNucleo " << gemm::nombreNucleo() << ", pico medido del micro-nucleo: "
+         << pico << " GFLOP/s\n";
+    for (int n : tamanos) {
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+        double operaciones = 2.0 * n * n * n;
+
+        Matriz c(1, 1, true, "C");
+        double tBloques = medirSegundos([&]() { c = a * b; });
+        double gflops = operaciones / tBloques / 1e9;
+
+        cout << "\n" << n << "x" << n << "\n";
+        cout << "  Por bloques: " << setw(9) << tBloques * 1e3 << " ms  " << setw(7) << gflops
+             << " GFLOP/s  (" << setw(5) << 100.0 * gflops / pico << "% del pico)\n";
+
+        double diferencia = 0.0;
+        if (n <= maximoIngenuo) {
+            Matriz r(1, 1, true, "R");
+            double tIngenuo = medirSegundos([&]() { r = a.multiplicarIngenuo(b); });
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    diferencia = max(diferencia, fabs(c.getValor(i, j) - r.getValor(i, j)));
+            cout << "  Ingenuo:     " << setw(9) << tIngenuo * 1e3 << " ms  " << setw(7)
+                 << operaciones / tIngenuo / 1e9 << " GFLOP/s  (" << tIngenuo / tBloques << "x)\n";
+        } else {
+            mt19937 generador(n);
+            uniform_int_distribution<int> indice(0, n - 1);
+            for (int muestra = 0; muestra < 256; muestra++) {
+                int i = indice(generador), j = indice(generador);
+                double directo = 0.0;
+                for (int k = 0; k < n; k++)
+                    directo += a.getValor(i, k) * b.getValor(k, j);
+                diferencia = max(diferencia, fabs(c.getValor(i, j) - directo));
+            }
         }
-        return datos[i];
+        cout << "  Diferencia maxima: " << scientific << diferencia << fixed << "\n";
     }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
 
-    // Calcula la transpuesta
-    Matriz transpuesta() const {
-        Matriz resultado(columnas, filas, true, nombre + "^T");
-        for (int i = 0; i < filas; i++)
-            for (int j = 0; j < columnas; j++)
-                resultado[j][i] = datos[i][j];
-        return resultado;
+// Escalado fuerte: el mismo producto con 1, 2, 4, ... 32 hilos
+void pruebaRendimientoHilos() {
+    const int n = 2000;
+    const int cuentas[] = {1, 2, 4, 8, 16, 32};
+    int hilosPrevios = gemm::getHilos();
+    Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+    double operaciones = 2.0 * n * n * n;
+
+    gemm::setHilos(1);
+    Matriz referencia = a * b;
+
+    cout << fixed << setprecision(2);
+    cout << "\nProducto " << n << "x" << n << ", nucleo " << gemm::nombreNucleo()
+         << ", nucleos de la maquina: " << thread::hardware_concurrency() << "\n";
+    cout << "  Hilos    Tiempo (ms)   GFLOP/s   Aceleracion   Eficiencia\n";
+    double tUno = 0.0;
+    for (int hilos : cuentas) {
+        gemm::setHilos(hilos);
+        gemm::grupo();   // Crea el grupo fuera de la medición
+        Matriz c(1, 1, true, "C");
+        double t = medirSegundos([&]() { c = a * b; });
+        if (hilos == 1)
+            tUno = t;
+
+        bool identico = memcmp(c.getDatos(), referencia.getDatos(),
+                               (size_t)n * c.getPaso() * sizeof(double)) == 0;
+        cout << "  " << setw(5) << hilos << "  " << setw(13) << t * 1e3 << "  " << setw(8)
+             << operaciones / t / 1e9 << "  " << setw(11) << tUno / t << "x  " << setw(9)
+             << 100.0 * tUno / t / hilos << "%" << (identico ? "" : "  (resultado distinto)") << "\n";
     }
+    gemm::setHilos(hilosPrevios);
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
 
-    // Multiplica por otra matriz
-    Matriz multiplicar(const Matriz& otra) const {
-        if (columnas != otra.filas) {
-            cerr << "Error: No se pueden multiplicar. Columnas de A ≠ Filas de B\n";
-            return Matriz(1, 1, true, "Error");
-        }
+// Error máximo de C en una muestra de elementos, contra productos punto
+// calculados en long double
+double errorMuestreado(const Matriz& a, const Matriz& b, const Matriz& c, int muestras) {
+    mt19937 generador(7);
+    uniform_int_distribution<int> fila(0, c.getFilas() - 1), columna(0, c.getColumnas() - 1);
+    double peor = 0.0;
+    for (int s = 0; s < muestras; s++) {
+        int i = fila(generador), j = columna(generador);
+        long double exacto = 0.0L;
+        for (int k = 0; k < a.getColumnas(); k++)
+            exacto += (long double)a.getValor(i, k) * b.getValor(k, j);
+        peor = max(peor, (double)fabsl(exacto - c.getValor(i, j)));
+    }
+    return peor;
+}
 
-        Matriz resultado(filas, otra.columnas, true, nombre + "×" + otra.nombre);
-        for (int i = 0; i < filas; i++)
-            for (int j = 0; j < otra.columnas; j++)
-                for (int k = 0; k < columnas; k++)
-                    resultado[i][j] += datos[i][k] * otra.datos[k][j];
-        return resultado;
+// Strassen-Winograd frente al producto clásico por bloques: tiempo y error
+// (contra long double) según el tamaño y la profundidad de la recursión
+void pruebaRendimientoStrassen() {
+    const int tamanos[] = {1024, 2048, 4096};
+    const int muestras = 512;
+
+    cout << "\nStrassen-Winograd (corte " << gemm::CORTE_STRASSEN << ") vs clasico, "
+         << gemm::getHilos() << " hilo(s)\n";
+    cout << "     n   Clasico (ms)  Strassen (ms)  Aceleracion   Error clasico  Error Strassen\n";
+    for (int n : tamanos) {
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+        Matriz c(1, 1, true, "C"), s(1, 1, true, "S");
+        double tClasico = medirSegundos([&]() { c = a * b; });
+        double tStrassen = medirSegundos([&]() { s = a.multiplicarStrassen(b); });
+        cout << fixed << setprecision(1) << setw(6) << n << setw(15) << tClasico * 1e3
+             << setw(15) << tStrassen * 1e3 << setprecision(2) << setw(12) << tClasico / tStrassen
+             << "x" << scientific << setw(16) << errorMuestreado(a, b, c, muestras)
+             << setw(16) << errorMuestreado(a, b, s, muestras) << "\n";
     }
 
-    // Sobrecarga del operador *
-    Matriz operator*(const Matriz& otra) const {
-        return multiplicar(otra);
+    const int n = 2048;
+    Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+    cout << "\nError segun la profundidad (n = " << n << ", elementos en [-1, 1])\n";
+    cout << "  Corte  Niveles   Error maximo\n";
+    for (int corte = 2048, niveles = 0; corte >= 64; corte /= 2, niveles++) {
+        Matriz s = a.multiplicarStrassen(b, corte);
+        cout << fixed << setw(7) << corte << setw(9) << niveles << scientific << setprecision(2)
+             << setw(15) << errorMuestreado(a, b, s, muestras) << "\n";
     }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
 
-    // Imprime la matriz
-    void imprimir(int precision = 2) const {
-        cout << "Matriz " << nombre << " (" << filas << "x" << columnas << "):\n";
-        for (int i = 0; i < filas; i++) {
-            cout << "[ ";
-            for (int j = 0; j < columnas; j++) {
-                cout << setw(8) << fixed << setprecision(precision) << datos[i][j];
-                if (j < columnas - 1) cout << ", ";
+// Transpuesta materializada (bucle directo vs bloques recursivos) y
+// productos con operandos transpuestos o submatrices usando vistas
+void pruebaRendimientoVistas() {
+    cout << fixed << setprecision(2);
+    for (int n : {1000, 4096}) {
+        Matriz a(n, n, -1.0, 1.0, "A");
+        Matriz directa(n, n, false, "D");
+        double tDirecta = medirSegundos([&]() {
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    directa.fila(j)[i] = a.fila(i)[j];
+        });
+        Matriz recursiva(1, 1, true, "R");
+        double tRecursiva = medirSegundos([&]() { recursiva = a.transpuesta(); });
+        bool iguales = memcmp(directa.getDatos(), recursiva.getDatos(),
+                              (size_t)n * directa.getPaso() * sizeof(double)) == 0;
+        double gb = 2.0 * n * n * sizeof(double) / 1e9;
+        cout << "\nTranspuesta " << n << "x" << n << "\n";
+        cout << "  Bucle directo:       " << setw(9) << tDirecta * 1e3 << " ms  " << setw(6)
+             << gb / tDirecta << " GB/s\n";
+        cout << "  Bloques recursivos:  " << setw(9) << tRecursiva * 1e3 << " ms  " << setw(6)
+             << gb / tRecursiva << " GB/s  (" << (iguales ? "iguales" : "DISTINTAS") << ")\n";
+    }
+
+    const int n = 2000;
+    Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+    Matriz copia(1, 1, true, "C"), conVista(1, 1, true, "V");
+    double tCopia = medirSegundos([&]() { copia = a.transpuesta() * b; });
+    double tVista = medirSegundos([&]() { conVista = a.vistaTranspuesta() * b; });
+    cout << "\nA^T * B con n = " << n << "\n";
+    cout << "  Transpuesta copiada: " << setw(9) << tCopia * 1e3 << " ms\n";
+    cout << "  Vista transpuesta:   " << setw(9) << tVista * 1e3 << " ms  (reserva "
+         << (size_t)n * n * sizeof(double) / (1 << 20) << " MiB menos)\n";
+
+    double tSubCopia = medirSegundos([&]() {
+        copia = Matriz(a.submatriz(0, 0, n / 2, n, 2, 1)) * Matriz(b.rangoColumnas(n / 4, n / 2));
+    });
+    double tSubVista = medirSegundos([&]() {
+        conVista = a.submatriz(0, 0, n / 2, n, 2, 1) * b.rangoColumnas(n / 4, n / 2);
+    });
+    double diferencia = 0.0;
+    for (int i = 0; i < copia.getFilas(); i += 7)
+        for (int j = 0; j < copia.getColumnas(); j += 7)
+            diferencia = max(diferencia, fabs(copia.getValor(i, j) - conVista.getValor(i, j)));
+    cout << "Filas pares de A por columnas centrales de B\n";
+    cout << "  Submatrices copiadas: " << setw(8) << tSubCopia * 1e3 << " ms\n";
+    cout << "  Vistas:               " << setw(8) << tSubVista * 1e3 << " ms\n";
+    cout << "  Diferencia maxima: " << scientific << diferencia << "\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Evalúa una cadena de forma ansiosa (izquierda a derecha) y perezosa
+template <size_t N>
+void medirCadenaPerezosa(const string& titulo, const ExpresionProducto<N>& expresion) {
+    const array<VistaMatriz, N>& factores = expresion.getFactores();
+    Matriz ansiosa(1, 1, true, "E");
+    double tAnsiosa = medirSegundos([&]() {
+        ansiosa = Matriz::producto(factores[0], factores[1]);
+        for (size_t i = 2; i < N; i++)
+            ansiosa = ansiosa.multiplicar(factores[i]);
+    });
+    Matriz perezosa(1, 1, true, "P");
+    double tPerezosa = medirSegundos([&]() { perezosa = expresion; });
+
+    double diferencia = 0.0, escala = 0.0;
+    for (int i = 0; i < perezosa.getFilas(); i++)
+        for (int j = 0; j < perezosa.getColumnas(); j++) {
+            diferencia = max(diferencia, fabs(perezosa.getValor(i, j) - ansiosa.getValor(i, j)));
+            escala = max(escala, fabs(ansiosa.getValor(i, j)));
+        }
+
+    cout << "\n" << titulo << "\n";
+    cout << "  Izquierda a derecha: " << setw(9) << tAnsiosa * 1e3 << " ms  "
+         << scientific << setprecision(2) << expresion.costoIzquierdaDerecha() << " mult.\n";
+    cout << fixed << "  Orden " << expresion.parentesis() << ": " << setw(9) << tPerezosa * 1e3
+         << " ms  " << scientific << expresion.costoOptimo() << " mult.  (diferencia relativa "
+         << diferencia / escala << ")\n" << fixed;
+}
+
+void pruebaRendimientoCadenas() {
+    cout << fixed << setprecision(2);
+    {
+        const int n = 1500;
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B"), x(n, 1, -1.0, 1.0, "x");
+        medirCadenaPerezosa("A * B * x, n = 1500", a * b * x);
+    }
+    {
+        Matriz a(2000, 50, -1.0, 1.0, "A"), b(50, 2000, -1.0, 1.0, "B");
+        Matriz c(2000, 50, -1.0, 1.0, "C"), d(50, 2000, -1.0, 1.0, "D");
+        medirCadenaPerezosa("A(2000x50) * B(50x2000) * C(2000x50) * D(50x2000)", a * b * c * d);
+    }
+    {
+        // Escalares y transpuestas: un solo escalado y ninguna copia
+        const int n = 1500;
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B"), c(n, n, true, "C");
+        Matriz copia(1, 1, true, "K");
+        double tCopias = medirSegundos([&]() {
+            Matriz at = a.transpuesta();
+            Matriz bt = b.transpuesta();
+            copia = at.multiplicar(bt);
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    copia.fila(i)[j] *= 2.0 * 0.25;
+        });
+        long long reservasPrevias = Matriz::reservas;
+        double tFusion = medirSegundos([&]() {
+            c = 2.0 * a.vistaTranspuesta() * (b.vistaTranspuesta() * 0.25);
+        });
+        cout << "\n2 * A^T * (B^T * 0.25), n = " << n << "\n";
+        cout << "  Copias y escalado aparte: " << setw(9) << tCopias * 1e3 << " ms\n";
+        cout << "  Expresion fusionada:      " << setw(9) << tFusion * 1e3 << " ms  ("
+             << Matriz::reservas - reservasPrevias << " reservas)\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Bucle iterativo típico: cada versión "con temporales" crea una matriz por
+// vuelta; la versión en sitio escribe siempre en la misma memoria
+void pruebaRendimientoEnSitio() {
+    cout << fixed << setprecision(2);
+    {
+        const int n = 256, vueltas = 200;
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+        Matriz c1(n, n, true, "C"), c2(n, n, true, "C");
+        long long reservasPrevias = Matriz::reservas;
+        double tTemporal = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++) {
+                Matriz t = a * b;
+                for (int i = 0; i < n; i++)
+                    for (int j = 0; j < n; j++)
+                        c1.fila(i)[j] += t.fila(i)[j];
             }
-            cout << " ]\n";
+        });
+        long long reservasTemporal = Matriz::reservas - reservasPrevias;
+        reservasPrevias = Matriz::reservas;
+        double tSitio = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++)
+                blas::gemm(1.0, a, b, 1.0, c2);
+        });
+        long long reservasSitio = Matriz::reservas - reservasPrevias;
+        double diferencia = 0.0;
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                diferencia = max(diferencia, fabs(c1.getValor(i, j) - c2.getValor(i, j)));
+        cout << "\nC += A * B, n = " << n << ", " << vueltas << " vueltas\n";
+        cout << "  Con temporales:      " << setw(9) << tTemporal * 1e3 << " ms  ("
+             << reservasTemporal << " reservas)\n";
+        cout << "  gemm(1, A, B, 1, C): " << setw(9) << tSitio * 1e3 << " ms  (" << reservasSitio
+             << " reservas, diferencia " << scientific << diferencia << fixed << ")\n";
+    }
+    {
+        const int n = 2000, vueltas = 200;
+        Matriz a(n, n, -1.0, 1.0, "A"), x(n, 1, -1.0, 1.0, "x");
+        vector<double> xv(n), yv(n);
+        for (int i = 0; i < n; i++)
+            xv[i] = x.getValor(i, 0);
+        Matriz y(1, 1, true, "y");
+        long long reservasPrevias = Matriz::reservas;
+        double tTemporal = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++)
+                y = a * x;
+        });
+        long long reservasTemporal = Matriz::reservas - reservasPrevias;
+        double tSitio = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++)
+                blas::gemv(1.0, a, xv, 0.0, yv);
+        });
+        double tTranspuesta = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++)
+                blas::gemv(1.0, a.vistaTranspuesta(), xv, 0.0, yv);
+        });
+        double gb = (double)n * n * sizeof(double) * vueltas / 1e9;
+        cout << "\ny = A * x, n = " << n << ", " << vueltas << " vueltas\n";
+        cout << "  Expresion y = A * x: " << setw(9) << tTemporal * 1e3 << " ms  ("
+             << reservasTemporal << " reservas)\n";
+        cout << "  gemv:                " << setw(9) << tSitio * 1e3 << " ms  (" << gb / tSitio
+             << " GB/s)\n";
+        cout << "  gemv con A^T:        " << setw(9) << tTranspuesta * 1e3 << " ms  ("
+             << gb / tTranspuesta << " GB/s)\n";
+    }
+    {
+        const int n = 2000, vueltas = 50;
+        Matriz a1(n, n, true, "A"), a2(n, n, true, "A");
+        Matriz x(n, 1, -1.0, 1.0, "x"), y(1, n, -1.0, 1.0, "y");
+        vector<double> xv(n), yv(n);
+        for (int i = 0; i < n; i++) {
+            xv[i] = x.getValor(i, 0);
+            yv[i] = y.getValor(0, i);
         }
-        cout << endl;
+        long long reservasPrevias = Matriz::reservas;
+        double tTemporal = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++) {
+                Matriz t = x * y;
+                for (int i = 0; i < n; i++)
+                    for (int j = 0; j < n; j++)
+                        a1.fila(i)[j] += t.fila(i)[j];
+            }
+        });
+        long long reservasTemporal = Matriz::reservas - reservasPrevias;
+        double tSitio = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++)
+                blas::ger(1.0, xv, yv, a2);
+        });
+        cout << "\nA += x * y^T, n = " << n << ", " << vueltas << " vueltas\n";
+        cout << "  Con temporales:      " << setw(9) << tTemporal * 1e3 << " ms  ("
+             << reservasTemporal << " reservas)\n";
+        cout << "  ger:                 " << setw(9) << tSitio * 1e3 << " ms\n";
     }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
 
-    // Establece o obtiene valores individuales
-    void setValor(int i, int j, double valor) {
-        if (i >= 0 && i < filas && j >= 0 && j < columnas)
-            datos[i][j] = valor;
-        else
-            cerr << "Error: Índices fuera de rango.\n";
+// Matriz densa con una fracción "densidad" de elementos distintos de cero
+Matriz matrizPocoDensa(int filas, int columnas, double densidad, unsigned semilla, string nombre) {
+    Matriz m(filas, columnas, true, nombre);
+    mt19937 generador(semilla);
+    uniform_real_distribution<double> sorteo(0.0, 1.0), valor(-1.0, 1.0);
+    for (int i = 0; i < filas; i++)
+        for (int j = 0; j < columnas; j++)
+            if (sorteo(generador) < densidad)
+                m.fila(i)[j] = valor(generador);
+    return m;
+}
+
+void pruebaRendimientoDispersas() {
+    const int n = 2000;
+    cout << fixed << setprecision(2);
+    cout << "\nProducto de " << n << "x" << n << " con un factor poco denso (incluye la conversion a CSR)\n";
+    cout << "  Densidad     Denso      S x D      D x S   Automatico\n";
+    Matriz b(n, n, -1.0, 1.0, "B");
+    for (double densidad : {0.005, 0.02, 0.05, 0.1, 0.2}) {
+        Matriz a = matrizPocoDensa(n, n, densidad, 1, "A");
+        Matriz c(1, 1, true, "C");
+        double tDenso = medirSegundos([&]() { c = a * b; });
+        double tIzquierda = medirSegundos([&]() { c = MatrizDispersa(a).multiplicar(b); });
+        double tDerecha = medirSegundos([&]() { c = multiplicar(b, MatrizDispersa(a)); });
+        double tAutomatico = medirSegundos([&]() { c = multiplicarAutomatico(a, b); });
+        cout << "  " << setw(6) << densidad * 100 << " %" << setw(9) << tDenso * 1e3 << " ms"
+             << setw(8) << tIzquierda * 1e3 << " ms" << setw(8) << tDerecha * 1e3 << " ms"
+             << setw(10) << tAutomatico * 1e3 << " ms\n";
     }
 
-    double getValor(int i, int j) const {
-        if (i >= 0 && i < filas && j >= 0 && j < columnas)
-            return datos[i][j];
-        cerr << "Error: Índices fuera de rango.\n";
-        return 0.0;
+    {
+        const int vueltas = 100;
+        Matriz a = matrizPocoDensa(n, n, 0.01, 2, "A");
+        MatrizDispersa s(a);
+        vector<double> x(n, 1.0), y(n);
+        double tDenso = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++)
+                blas::gemv(1.0, a, x, 0.0, y);
+        });
+        double tDisperso = medirSegundos([&]() {
+            for (int r = 0; r < vueltas; r++)
+                s.multiplicarVector(1.0, x.data(), 0.0, y.data());
+        });
+        cout << "\ny = A * x, densidad 1 %, " << vueltas << " vueltas\n";
+        cout << "  gemv denso: " << setw(9) << tDenso * 1e3 << " ms\n";
+        cout << "  CSR:        " << setw(9) << tDisperso * 1e3 << " ms  (" << tDenso / tDisperso
+             << "x)\n";
     }
-};
 
-//  FUNCIONES AUXILIARES
-void mostrarMatricesAlmacenadas(const vector<Matriz*>& matrices) {
-    if (matrices.empty()) {
-        cout << "No hay matrices almacenadas.\n";
+    {
+        Matriz a = matrizPocoDensa(n, n, 0.005, 3, "A"), c = matrizPocoDensa(n, n, 0.005, 4, "C");
+        MatrizDispersa sa(a), sc(c);
+        Matriz densa(1, 1, true, "D");
+        double tDenso = medirSegundos([&]() { densa = a * c; });
+        MatrizDispersa producto(1, 1);
+        double tDisperso = medirSegundos([&]() { producto = sa.multiplicar(sc); });
+        cout << "\nA * C, ambas con densidad 0.5 %\n";
+        cout << "  Denso:             " << setw(9) << tDenso * 1e3 << " ms\n";
+        cout << "  Gustavson (CSR):   " << setw(9) << tDisperso * 1e3 << " ms  (resultado con "
+             << producto.getDensidad() * 100 << " % de no ceros)\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+void pruebaRendimientoArchivos() {
+    const int n = 4096;
+    string ruta = (filesystem::temp_directory_path() / "prueba_matriz.bin").string();
+    Matriz a(n, n, -1.0, 1.0, "A");
+    double megabytes = (double)n * n * sizeof(double) / 1e6;
+
+    cout << fixed << setprecision(2);
+    cout << "\nMatriz de " << n << "x" << n << " (" << megabytes << " MB) en " << ruta << "\n";
+    bool guardado = false;
+    double tGuardar = medirSegundos([&]() { guardado = guardarBinario(a, ruta); });
+    if (!guardado) {
+        cout.unsetf(ios::floatfield);
+        cout << setprecision(6);
         return;
     }
+    cout << "  Guardar (por filas):      " << setw(10) << tGuardar * 1e3 << " ms  ("
+         << megabytes / tGuardar << " MB/s)\n";
+    {
+        optional<MatrizMapeada> archivo;
+        double tAbrir = medirSegundos([&]() { archivo.emplace(ruta); });
+        cout << "  Abrir con mmap:           " << setw(10) << tAbrir * 1e6 << " us\n";
+        double suma = 0.0;
+        double tRecorrer = medirSegundos([&]() {
+            const VistaMatriz& v = archivo->vista();
+            for (int i = 0; i < v.getFilas(); i++)
+                for (int j = 0; j < v.getColumnas(); j++)
+                    suma += v(i, j);
+        });
+        cout << "  Primer recorrido:         " << setw(10) << tRecorrer * 1e3 << " ms  (suma "
+             << suma << ")\n";
+        Matriz copia(1, 1, true, "C");
+        double tCopiar = medirSegundos([&]() { copia = Matriz(archivo->vista()); });
+        cout << "  Copiar a una Matriz:      " << setw(10) << tCopiar * 1e3 << " ms\n";
+    }
+    {
+        // Referencia: texto con un número por elemento, como lo haría cin
+        string rutaTexto = ruta + ".txt";
+        {
+            ofstream texto(rutaTexto);
+            texto << setprecision(17);
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    texto << a.getValor(i, j) << (j + 1 < n ? ' ' : '\n');
+        }
+        Matriz leida(n, n, true, "T");
+        double tTexto = medirSegundos([&]() {
+            ifstream texto(rutaTexto);
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < n; j++)
+                    texto >> leida.fila(i)[j];
+        });
+        cout << "  Leer como texto:          " << setw(10) << tTexto * 1e3 << " ms\n";
+        remove(rutaTexto.c_str());
+    }
+    remove(ruta.c_str());
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
 
-    cout << "\n=== MATRICES ALMACENADAS ===\n";
-    for (size_t i = 0; i < matrices.size(); i++) {
-        cout << i + 1 << ". " << matrices[i]->getNombre()
-             << " (" << matrices[i]->getFilas() << "x"
-             << matrices[i]->getColumnas() << ")\n";
+void pruebaRendimientoFueraDeMemoria() {
+    const int n = 2048;
+    filesystem::path carpeta = filesystem::temp_directory_path();
+    string rutaA = (carpeta / "prueba_a.bin").string(), rutaB = (carpeta / "prueba_b.bin").string();
+    string rutaC = (carpeta / "prueba_c.bin").string();
+    Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+    if (!guardarBinario(a, rutaA) || !guardarBinario(b, rutaB))
+        return;
+
+    double operaciones = 2.0 * n * n * n;
+    cout << fixed << setprecision(2);
+    cout << "\nC = A * B, n = " << n << " (" << 3.0 * n * n * sizeof(double) / 1048576.0
+         << " MB entre los tres archivos)\n";
+    Matriz referencia(1, 1, true, "R");
+    double tMemoria = medirSegundos([&]() { referencia = a * b; });
+    cout << "  En memoria:            " << setw(9) << tMemoria * 1e3 << " ms  " << setw(7)
+         << operaciones / tMemoria / 1e9 << " GFLOP/s\n";
+
+    // El presupuesto incluye los paneles del núcleo; las teselas reciben el resto
+    size_t paneles = gemm::bytesPaneles();
+    cout << "  Paneles del nucleo:    " << setw(9) << paneles / 1048576.0 << " MB (" << gemm::getHilos()
+         << " hilos)\n";
+    for (size_t megas : {4, 16, 64}) {
+        EstadisticasDisco estadisticas;
+        if (!multiplicarEnDisco(rutaA, rutaB, rutaC, paneles + (megas << 20), &estadisticas))
+            break;
+        MatrizMapeada c(rutaC);
+        double diferencia = 0.0;
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                diferencia = max(diferencia, fabs(c.vista()(i, j) - referencia.getValor(i, j)));
+        cout << "  Paneles + " << setw(3) << megas << " MB:      " << setw(9) << estadisticas.segundos * 1e3
+             << " ms  " << setw(7) << operaciones / estadisticas.segundos / 1e9 << " GFLOP/s  (tesela "
+             << estadisticas.tesela << ", " << estadisticas.bytesBuferes / 1048576.0 << " MB de buferes, "
+             << estadisticas.bytesLeidos / 1048576.0 << " MB leidos, " << estadisticas.segundosEspera * 1e3
+             << " ms esperando al disco, diferencia " << scientific << diferencia << fixed << ")\n";
     }
-    cout << endl;
+    remove(rutaA.c_str());
+    remove(rutaB.c_str());
+    remove(rutaC.c_str());
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
 }
 
-int seleccionarMatriz(const vector<Matriz*>& matrices, const string& mensaje) {
-    if (matrices.empty()) {
-        cout << "No hay matrices almacenadas.\n";
-        return -1;
+// LU sin bloques (eliminación de Gauss fila por fila), como referencia
+void factorizarSinBloques(Matriz& a) {
+    int n = a.getFilas();
+    for (int j = 0; j < n; j++) {
+        int p = j;
+        for (int i = j + 1; i < n; i++)
+            if (fabs(a.fila(i)[j]) > fabs(a.fila(p)[j]))
+                p = i;
+        swap_ranges(a.fila(j), a.fila(j) + n, a.fila(p));
+        if (a.fila(j)[j] == 0.0)
+            continue;
+        for (int i = j + 1; i < n; i++) {
+            double l = a.fila(i)[j] /= a.fila(j)[j];
+            for (int c = j + 1; c < n; c++)
+                a.fila(i)[c] -= l * a.fila(j)[c];
+        }
     }
+}
 
-    mostrarMatricesAlmacenadas(matrices);
-    int opcion;
-    cout << mensaje;
-    cin >> opcion;
+void pruebaRendimientoLU() {
+    cout << fixed << setprecision(2);
+    cout << "\nFactorizacion P A = L U (2n^3/3 operaciones) y residuo ||Ax - b|| / (||A|| ||x||)\n";
+    cout << "      n    Por bloques   GFLOP/s   Sin bloques   Resolver x     Residuo\n";
+    for (int n : {500, 1000, 2000, 4000, 8000}) {
+        Matriz a(n, n, -1.0, 1.0, "A");
+        double operaciones = 2.0 * n * n * n / 3.0;
+        optional<DescomposicionLU> lu;
+        double tBloques = medirSegundos([&]() { lu.emplace(a); });
+
+        vector<double> b(n), x, ax(n);
+        for (int i = 0; i < n; i++)
+            b[i] = a.getValor(i, i % 7);
+        double tResolver = medirSegundos([&]() { x = lu->resolver(b); });
+        blas::gemv(1.0, a, x, 0.0, ax);
+        double error = 0.0, normaA = 0.0, normaX = 0.0;
+        for (int i = 0; i < n; i++) {
+            double fila = 0.0;
+            for (int j = 0; j < n; j++)
+                fila += fabs(a.fila(i)[j]);
+            normaA = max(normaA, fila);
+            normaX = max(normaX, fabs(x[i]));
+            error = max(error, fabs(ax[i] - b[i]));
+        }
+
+        cout << "  " << setw(5) << n << setw(12) << tBloques * 1e3 << " ms" << setw(10)
+             << operaciones / tBloques / 1e9;
+        if (n <= 2000) {
+            Matriz copia = a;
+            double tSinBloques = medirSegundos([&]() { factorizarSinBloques(copia); });
+            cout << setw(11) << tSinBloques * 1e3 << " ms";
+        } else {
+            cout << setw(14) << "-";
+        }
+        cout << setw(10) << tResolver * 1e3 << " ms" << scientific << setw(12)
+             << error / (normaA * normaX) << fixed << "\n";
+    }
+
+    {
+        const int n = 2000, lados = 200;
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, lados, -1.0, 1.0, "B");
+        DescomposicionLU lu(a);
+        Matriz x(1, 1, true, "X");
+        double tBloque = medirSegundos([&]() { x = lu.resolver(b); });
+        double tUnoAUno = medirSegundos([&]() {
+            vector<double> columna(n);
+            for (int c = 0; c < lados; c++) {
+                for (int i = 0; i < n; i++)
+                    columna[i] = b.fila(i)[c];
+                vector<double> solucion = lu.resolver(columna);
+            }
+        });
+        Matriz inversa(1, 1, true, "I");
+        double tInversa = medirSegundos([&]() { inversa = lu.inversa(); });
+        cout << "\nn = " << n << " ya factorizada\n";
+        cout << "  " << lados << " lados derechos juntos:  " << setw(9) << tBloque * 1e3 << " ms\n";
+        cout << "  " << lados << " lados derechos uno a uno:" << setw(9) << tUnoAUno * 1e3 << " ms\n";
+        cout << "  Inversa:                    " << setw(9) << tInversa * 1e3 << " ms\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Suma ponderada por posición, para comparar dos llenados sin guardar copias
+double firmaMatriz(const Matriz& m) {
+    double firma = 0.0;
+    for (int i = 0; i < m.getFilas(); i++)
+        for (int j = 0; j < m.getColumnas(); j++)
+            firma += m.fila(i)[j] * (1.0 + i * 1e-3 + j * 1e-6);
+    return firma;
+}
+
+void pruebaRendimientoAleatorios() {
+    using aleatorio::Distribucion;
+    const int n = 4000;
+    const uint64_t semilla = 12345;
+    Matriz m(n, n, true, "M");
+    int hilosPrevios = gemm::getHilos();
+
+    cout << fixed << setprecision(2);
+    cout << "\nLlenar " << n << "x" << n << " (" << (double)n * n / 1e6 << " millones de elementos)\n";
+    double tRand = medirSegundos([&]() {
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                m.fila(i)[j] = -1.0 + 2.0 * (rand() % 100) / 99.0;
+    });
+    cout << "  rand() % 100 (original):   " << setw(9) << tRand * 1e3 << " ms\n";
+
+    struct Caso { const char* nombre; Distribucion distribucion; };
+    const Caso casos[] = {{"Uniforme [-1, 1):         ", Distribucion::uniformeEntre(-1.0, 1.0)},
+                          {"Normal (0, 1):            ", Distribucion::normal(0.0, 1.0)},
+                          {"Entera [0, 9]:            ", Distribucion::entera(0, 9)}};
+    for (const Caso& caso : casos) {
+        gemm::setHilos(1);
+        double tUno = medirSegundos([&]() { m.llenarAleatorio(caso.distribucion, semilla); });
+        double firmaUno = firmaMatriz(m);
+        gemm::setHilos(hilosPrevios);
+        double tVarios = medirSegundos([&]() { m.llenarAleatorio(caso.distribucion, semilla); });
+        bool iguales = firmaMatriz(m) == firmaUno;
+        cout << "  " << caso.nombre << setw(9) << tUno * 1e3 << " ms (1 hilo)" << setw(9)
+             << tVarios * 1e3 << " ms (" << hilosPrevios << " hilos), "
+             << (iguales ? "mismos valores" : "VALORES DISTINTOS") << "\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Sesión simulada: llena el registro con "vivas" matrices de tamaños al azar
+// y luego repite "operaciones" veces borrar una al azar y crear otra. Las
+// matrices se crean en ceros, así que se cuenta también el costo de tocar
+// páginas nuevas que el sistema entrega al reservar.
+double simularSesion(int vivas, int operaciones, uint64_t semilla) {
+    uint64_t contador = 0;
+    auto siguiente = [&](int limite) {
+        return (int)(aleatorio::mezclar(semilla + ++contador * aleatorio::INCREMENTO) % limite);
+    };
+    // Pocos tamaños típicos, como en una sesión real, con variaciones
+    const int tamanos[] = {4, 16, 64, 100, 128, 250, 256, 500, 512};
+    auto tamano = [&]() {
+        int base = tamanos[siguiente(9)];
+        return max(1, base + siguiente(base / 8 + 1) - base / 16);
+    };
+
+    RegistroMatrices registro;
+    return medirSegundos([&]() {
+        for (int k = 0; k < vivas; k++)
+            registro.agregar(Matriz(tamano(), tamano(), true, "S"));
+        for (int k = 0; k < operaciones; k++) {
+            registro.eliminar(registro.manejadorEn(siguiente((int)registro.tamano())));
+            registro.agregar(Matriz(tamano(), tamano(), true, "S"));
+        }
+        registro.vaciar();
+    });
+}
+
+void pruebaRendimientoPool() {
+    const int vivas = 200, operaciones = 20000;
+    const uint64_t semilla = 2024;
+    PoolMatrices& pool = PoolMatrices::global();
+
+    cout << "\nSesion de " << vivas << " matrices vivas y " << operaciones
+         << " altas/bajas de tamaños al azar (4 a 512)\n";
+
+    pool.setHabilitado(false);
+    pool.reiniciarEstadisticas();
+    double tSistema = simularSesion(vivas, operaciones, semilla);
+    cout << "\nSin pool (cada bloque va y vuelve al sistema):\n";
+    pool.imprimirEstadisticas();
+
+    pool.setHabilitado(true);
+    pool.reiniciarEstadisticas();
+    double tPool = simularSesion(vivas, operaciones, semilla);
+    cout << "\nCon pool por clases de tamaño:\n";
+    pool.imprimirEstadisticas();
 
-    if (opcion < 1 || opcion > (int)matrices.size()) {
+    cout << fixed << setprecision(2);
+    cout << "\nTiempo sin pool: " << setw(9) << tSistema * 1e3 << " ms\n";
+    cout << "Tiempo con pool: " << setw(9) << tPool * 1e3 << " ms ("
+         << tSistema / tPool << "x)\n";
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Producto de "cantidad" pares de matrices N×N con Matriz (una reserva y un
+// nombre por resultado), con MatrizFija (arreglo de matrices) y con el lote
+// en estructura de arreglos; los tres deben dar lo mismo. Los pares caben
+// en caché y se repiten, para medir el cálculo y no la memoria.
+template <int N>
+void medirPequenas(int cantidad, int repeticiones) {
+    const int cantidadMatriz = cantidad;
+    const int repeticionesMatriz = max(1, repeticiones / 10);   // Matriz es mucho más lenta
+    vector<MatrizFija<N, N>> a(cantidad), b(cantidad), c(cantidad);
+    LoteMatricesFijas<N, N> loteA(cantidad), loteB(cantidad), loteC(cantidad);
+    for (int m = 0; m < cantidad; m++) {
+        aleatorio::llenar(a[m].getDatos(), N, N, N, aleatorio::Distribucion::uniformeEntre(-1, 1), 2 * m);
+        aleatorio::llenar(b[m].getDatos(), N, N, N, aleatorio::Distribucion::uniformeEntre(-1, 1), 2 * m + 1);
+        loteA.asignar(m, a[m]);
+        loteB.asignar(m, b[m]);
+    }
+    vector<Matriz> matrizA, matrizB;
+    for (int m = 0; m < cantidadMatriz; m++) {
+        matrizA.push_back(a[m].aMatriz("A"));
+        matrizB.push_back(b[m].aMatriz("B"));
+    }
+
+    double diferencia = 0.0;
+    double tMatriz = medirSegundos([&]() {
+        for (int r = 0; r < repeticionesMatriz; r++)
+            for (int m = 0; m < cantidadMatriz; m++)
+                Matriz producto = matrizA[m].multiplicar(matrizB[m]);
+    }) / ((double)cantidadMatriz * repeticionesMatriz);
+    double tFija = medirSegundos([&]() {
+        for (int r = 0; r < repeticiones; r++)
+            for (int m = 0; m < cantidad; m++)
+                c[m] = a[m] * b[m];
+    }) / ((double)cantidad * repeticiones);
+    double tLote = medirSegundos([&]() {
+        for (int r = 0; r < repeticiones; r++)
+            multiplicarLote(loteA, loteB, loteC);
+    }) / ((double)cantidad * repeticiones);
+
+    for (int m = 0; m < cantidad; m++) {
+        MatrizFija<N, N> delLote = loteC.obtener(m);
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                diferencia = max(diferencia, fabs(delLote[i][j] - c[m][i][j]));
+    }
+    for (int m = 0; m < cantidadMatriz; m++) {
+        Matriz producto = matrizA[m].multiplicar(matrizB[m]);
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                diferencia = max(diferencia, fabs(producto[i][j] - c[m][i][j]));
+    }
+
+    cout << "  " << N << "x" << N << ": Matriz " << setw(8) << tMatriz * 1e9 << " ns, MatrizFija "
+         << setw(6) << tFija * 1e9 << " ns (" << setw(5) << tMatriz / tFija << "x), lote "
+         << setw(6) << tLote * 1e9 << " ns (" << setw(6) << tMatriz / tLote << "x), diferencia "
+         << scientific << setprecision(1) << diferencia << fixed << setprecision(2) << "\n";
+}
+
+void pruebaRendimientoPequenas() {
+    const int cantidad = 1024, repeticiones = 2000;
+    cout << fixed << setprecision(2);
+    cout << "\nTiempo por producto de matrices pequeñas (" << cantidad << " pares, "
+         << repeticiones << " veces)\n";
+    medirPequenas<3>(cantidad, repeticiones);
+    medirPequenas<4>(cantidad, repeticiones);
+    medirPequenas<6>(cantidad, repeticiones);
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+void pruebaRendimientoPrecision() {
+    // Máximo error de c respecto a referencia, relativo al mayor elemento
+    auto errorRelativo = [](const Matriz& c, const Matriz& referencia) {
+        double error = 0.0, escala = 0.0;
+        for (int i = 0; i < c.getFilas(); i++)
+            for (int j = 0; j < c.getColumnas(); j++) {
+                error = max(error, fabs(c.fila(i)[j] - referencia.fila(i)[j]));
+                escala = max(escala, fabs(referencia.fila(i)[j]));
+            }
+        return escala > 0.0 ? error / escala : 0.0;
+    };
+
+    cout << fixed << setprecision(2);
+    cout << "\nMultiplicacion C = A B con distintos tipos de elemento\n";
+    cout << "      n   Tipo                     Tiempo   GFLOP/s   Error relativo\n";
+    for (int n : {1000, 2000}) {
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, n, -1.0, 1.0, "B");
+        MatrizDensa<double> ad(a), bd(b);
+        MatrizSimple af(a), bf(b);
+        double operaciones = 2.0 * n * n * n;
+        Matriz referencia(1, 1, true, "C"), c(1, 1, true, "C");
+
+        auto fila = [&](const char* tipo, double segundos, double error) {
+            cout << "  " << setw(5) << n << "   " << left << setw(20) << tipo << right << setw(9)
+                 << segundos * 1e3 << " ms" << setw(10) << operaciones / segundos / 1e9;
+            if (error >= 0.0)
+                cout << scientific << setw(17) << error << fixed;
+            cout << "\n";
+        };
+        fila("Matriz (double)", medirSegundos([&]() { referencia = a.multiplicar(b); }), -1.0);
+        double t = medirSegundos([&]() { c = ad.multiplicar(bd).aMatriz(); });
+        fila("Densa<double>", t, errorRelativo(c, referencia));
+        t = medirSegundos([&]() { c = af.multiplicar(bf).aMatriz(); });
+        fila("Densa<float>", t, errorRelativo(c, referencia));
+        t = medirSegundos([&]() { c = multiplicarMixto(af, bf); });
+        fila("Mixta (float/double)", t, errorRelativo(c, referencia));
+    }
+
+    cout << "\nResolver A X = B (10 lados derechos), residuo ||B - AX|| / (||A|| ||X|| + ||B||)\n";
+    cout << "      n   Metodo                   Tiempo   Pasos      Residuo\n";
+    for (int n : {1000, 2000, 4000}) {
+        Matriz a(n, n, -1.0, 1.0, "A"), b(n, 10, -1.0, 1.0, "B");
+        double normaA = normaInfinito(a), normaB = normaInfinito(b);
+        Matriz x(1, 1, true, "X"), r(1, 1, true, "R");
+
+        auto fila = [&](const char* metodo, double segundos, const string& pasos) {
+            cout << "  " << setw(5) << n << "   " << left << setw(20) << metodo << right << setw(9)
+                 << segundos * 1e3 << " ms" << setw(8) << pasos << scientific << setw(13)
+                 << residuoRelativo(a, b, x, r, normaA, normaB) << fixed << "\n";
+        };
+        fila("LU double", medirSegundos([&]() { x = DescomposicionLU(a).resolver(b); }), "-");
+        double t = medirSegundos([&]() {
+            x = DescomposicionLUGenerica<MatrizDensa<double>>(a).resolver(b).aMatriz();
+        });
+        fila("LU Densa<double>", t, "-");
+        t = medirSegundos([&]() { x = DescomposicionLUSimple(a).resolver(b).aMatriz(); });
+        fila("LU float", t, "-");
+        EstadisticasRefinamiento estadisticas;
+        t = medirSegundos([&]() { x = resolverRefinado(a, b, &estadisticas); });
+        fila(estadisticas.convergio ? "Refinado" : "Refinado (double)", t, to_string(estadisticas.pasos));
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+void configurarHilos() {
+    int hilos;
+    cout << "Hilos actuales: " << gemm::getHilos() << " (la maquina tiene "
+         << thread::hardware_concurrency() << ")\n";
+    cout << "Nuevo numero de hilos: ";
+    cin >> hilos;
+    if (hilos < 1) {
         cout << "Opción inválida.\n";
-        return -1;
+        return;
     }
+    gemm::setHilos(hilos);
+}
 
-    return opcion - 1;
+void menuRendimiento() {
+    int opcion;
+    cout << " PRUEBAS DE RENDIMIENTO \n";
+    cout << "1. Almacenamiento por filas vs bloque contiguo (reservas)\n";
+    cout << "2. Multiplicacion por bloques (SIMD) vs triple bucle\n";
+    cout << "3. Escalado de la multiplicacion con 1 a 32 hilos\n";
+    cout << "4. Configurar numero de hilos de la multiplicacion\n";
+    cout << "5. Strassen-Winograd vs producto clasico (tiempo y error)\n";
+    cout << "6. Transpuesta por bloques y productos con vistas\n";
+    cout << "7. Cadenas de productos: orden optimo y expresiones perezosas\n";
+    cout << "8. Operaciones en sitio (gemm, gemv, ger) vs temporales\n";
+    cout << "9. Matrices dispersas (CSR) vs producto denso\n";
+    cout << "10. Archivo binario con mmap vs texto\n";
+    cout << "11. Multiplicacion fuera de memoria (teselas desde disco)\n";
+    cout << "12. Descomposicion LU por bloques, resolver e inversa\n";
+    cout << "13. Generacion de matrices aleatorias (rand vs contador)\n";
+    cout << "14. Sesion con pool de memoria vs reservas del sistema\n";
+    cout << "15. Matrices pequeñas: Matriz vs MatrizFija vs lote\n";
+    cout << "16. Precision simple y mixta: float, mixta y refinamiento\n";
+    cout << "0. Volver\n";
+    cout << "Seleccione una opción: ";
+    cin >> opcion;
+
+    switch (opcion) {
+        case 1:
+            pruebaRendimientoAlmacenamiento();
+            break;
+        case 2:
+            pruebaRendimientoMultiplicacion();
+            break;
+        case 3:
+            pruebaRendimientoHilos();
+            break;
+        case 4:
+            configurarHilos();
+            break;
+        case 5:
+            pruebaRendimientoStrassen();
+            break;
+        case 6:
+            pruebaRendimientoVistas();
+            break;
+        case 7:
+            pruebaRendimientoCadenas();
+            break;
+        case 8:
+            pruebaRendimientoEnSitio();
+            break;
+        case 9:
+            pruebaRendimientoDispersas();
+            break;
+        case 10:
+            pruebaRendimientoArchivos();
+            break;
+        case 11:
+            pruebaRendimientoFueraDeMemoria();
+            break;
+        case 12:
+            pruebaRendimientoLU();
+            break;
+        case 13:
+            pruebaRendimientoAleatorios();
+            break;
+        case 14:
+            pruebaRendimientoPool();
+            break;
+        case 15:
+            pruebaRendimientoPequenas();
+            break;
+        case 16:
+            pruebaRendimientoPrecision();
+            break;
+        case 0:
+            break;
+        default:
+            cout << "Opción inválida.\n";
+    }
 }
 
 
@@ -241,10 +4521,10 @@ int seleccionarMatriz(const vector<Matriz*>& matrices, const string& mensaje) {
 
 int main() {
     setlocale(LC_ALL, "es_ES.UTF-8");
-    srand(time(0));
+    aleatorio::sembrar(time(0));
 
     int opcion;
-    vector<Matriz*> matrices;
+    RegistroMatrices registro;
 
     do {
 
@@ -260,9 +4540,15 @@ int main() {
         cout << "8. Modificar un elemento\n";
         cout << "9. Eliminar una matriz\n";
         cout << "10. Ejemplos predefinidos\n";
+        cout << "11. Pruebas de rendimiento\n";
+        cout << "12. Guardar una matriz en archivo binario\n";
+        cout << "13. Cargar una matriz desde archivo binario\n";
+        cout << "14. Determinante e inversa de una matriz\n";
+        cout << "15. Resolver un sistema A X = B\n";
+        cout << "16. Estadísticas de memoria\n";
         cout << "0. Salir\n";
 
-        cout << "Matrices almacenadas: " << matrices.size() << "\n";
+        cout << "Matrices almacenadas: " << registro.tamano() << "\n";
         cout << "Seleccione una opción: ";
         cin >> opcion;
         cout << endl;
@@ -283,8 +4569,7 @@ int main() {
                 cout << "Valor máximo: ";
                 cin >> max;
 
-                Matriz* nueva = new Matriz(filas, columnas, min, max, nombre);
-                matrices.push_back(nueva);
+                Matriz* nueva = registro.obtener(registro.agregar(Matriz(filas, columnas, min, max, nombre)));
 
                 cout << "\nMatriz creada exitosamente:\n";
                 nueva->imprimir();
@@ -302,8 +4587,7 @@ int main() {
                 cout << "Número de columnas: ";
                 cin >> columnas;
 
-                Matriz* nueva = new Matriz(filas, columnas, nombre);
-                matrices.push_back(nueva);
+                Matriz* nueva = registro.obtener(registro.agregar(Matriz(filas, columnas, nombre)));
 
                 cout << "\nMatriz creada exitosamente:\n";
                 nueva->imprimir();
@@ -312,33 +4596,34 @@ int main() {
 
             case 3: {
                 cout << " TODAS LAS MATRICES \n";
-                if (matrices.empty())
+                if (registro.vacio())
                     cout << "No hay matrices almacenadas.\n";
                 else
-                    for (auto* m : matrices) m->imprimir();
+                    for (size_t i = 0; i < registro.tamano(); i++)
+                        registro.obtener(registro.manejadorEn(i))->imprimir();
                 break;
             }
 
             case 4: {
                 cout << " MOSTRAR MATRIZ \n";
-                int idx = seleccionarMatriz(matrices, "Seleccione la matriz: ");
-                if (idx >= 0) matrices[idx]->imprimir();
+                Matriz* m = seleccionarMatriz(registro, "Seleccione la matriz: ");
+                if (m) m->imprimir();
                 break;
             }
 
             case 5: {
                 cout << " TRANSPUESTA \n";
-                int idx = seleccionarMatriz(matrices, "Seleccione la matriz: ");
-                if (idx >= 0) {
-                    matrices[idx]->imprimir();
-                    Matriz transpuesta = matrices[idx]->transpuesta();
+                Matriz* m = seleccionarMatriz(registro, "Seleccione la matriz: ");
+                if (m) {
+                    m->imprimir();
+                    Matriz transpuesta = m->transpuesta();
                     transpuesta.imprimir();
 
                     char guardar;
                     cout << "¿Desea guardar la transpuesta? (s/n): ";
                     cin >> guardar;
                     if (guardar == 's' || guardar == 'S') {
-                        matrices.push_back(new Matriz(transpuesta));
+                        registro.agregar(move(transpuesta));
                         cout << "Transpuesta guardada.\n";
                     }
                 }
@@ -347,30 +4632,31 @@ int main() {
 
             case 6: {
                 cout << " MULTIPLICAR MATRICES \n";
-                if (matrices.size() < 2) {
+                if (registro.tamano() < 2) {
                     cout << "Debe haber al menos dos matrices.\n";
                     break;
                 }
 
-                int idx1 = seleccionarMatriz(matrices, "Primera matriz: ");
-                if (idx1 < 0) break;
-                int idx2 = seleccionarMatriz(matrices, "Segunda matriz: ");
-                if (idx2 < 0) break;
+                Matriz* m1 = seleccionarMatriz(registro, "Primera matriz: ");
+                if (!m1) break;
+                Matriz* m2 = seleccionarMatriz(registro, "Segunda matriz: ");
+                if (!m2) break;
 
-                matrices[idx1]->imprimir();
-                matrices[idx2]->imprimir();
+                m1->imprimir();
+                m2->imprimir();
 
-                if (matrices[idx1]->getColumnas() != matrices[idx2]->getFilas()) {
+                if (m1->getColumnas() != m2->getFilas()) {
                     cout << "Error: Las columnas de la primera deben coincidir con las filas de la segunda.\n";
                 } else {
-                    Matriz resultado = (*matrices[idx1]) * (*matrices[idx2]);
+                    // Usa la ruta dispersa si alguna tiene pocos elementos no nulos
+                    Matriz resultado = multiplicarAutomatico(*m1, *m2);
                     resultado.imprimir();
 
                     char guardar;
                     cout << "¿Desea guardar el resultado? (s/n): ";
                     cin >> guardar;
                     if (guardar == 's' || guardar == 'S') {
-                        matrices.push_back(new Matriz(resultado));
+                        registro.agregar(move(resultado));
                         cout << "Resultado guardado.\n";
                     }
                 }
@@ -379,44 +4665,43 @@ int main() {
 
             case 7: {
                 cout << " ACCEDER A ELEMENTO \n";
-                int idx = seleccionarMatriz(matrices, "Seleccione la matriz: ");
-                if (idx >= 0) {
-                    matrices[idx]->imprimir();
+                Matriz* m = seleccionarMatriz(registro, "Seleccione la matriz: ");
+                if (m) {
+                    m->imprimir();
                     int i, j;
-                    cout << "Fila (0-" << matrices[idx]->getFilas() - 1 << "): ";
+                    cout << "Fila (0-" << m->getFilas() - 1 << "): ";
                     cin >> i;
-                    cout << "Columna (0-" << matrices[idx]->getColumnas() - 1 << "): ";
+                    cout << "Columna (0-" << m->getColumnas() - 1 << "): ";
                     cin >> j;
-                    cout << "Valor: " << (*matrices[idx])[i][j] << endl;
+                    cout << "Valor: " << (*m)[i][j] << endl;
                 }
                 break;
             }
 
             case 8: {
                 cout << " MODIFICAR ELEMENTO \n";
-                int idx = seleccionarMatriz(matrices, "Seleccione la matriz: ");
-                if (idx >= 0) {
-                    matrices[idx]->imprimir();
+                Matriz* m = seleccionarMatriz(registro, "Seleccione la matriz: ");
+                if (m) {
+                    m->imprimir();
                     int i, j; double valor;
-                    cout << "Fila (0-" << matrices[idx]->getFilas() - 1 << "): ";
+                    cout << "Fila (0-" << m->getFilas() - 1 << "): ";
                     cin >> i;
-                    cout << "Columna (0-" << matrices[idx]->getColumnas() - 1 << "): ";
+                    cout << "Columna (0-" << m->getColumnas() - 1 << "): ";
                     cin >> j;
                     cout << "Nuevo valor: ";
                     cin >> valor;
-                    (*matrices[idx])[i][j] = valor;
-                    matrices[idx]->imprimir();
+                    (*m)[i][j] = valor;
+                    m->imprimir();
                 }
                 break;
             }
 
             case 9: {
                 cout << "ELIMINAR MATRIZ \n";
-                int idx = seleccionarMatriz(matrices, "Seleccione la matriz a eliminar: ");
-                if (idx >= 0) {
-                    cout << "Eliminando matriz " << matrices[idx]->getNombre() << "...\n";
-                    delete matrices[idx];
-                    matrices.erase(matrices.begin() + idx);
+                RegistroMatrices::Manejador h = seleccionarManejador(registro, "Seleccione la matriz a eliminar: ");
+                if (h.esValido()) {
+                    cout << "Eliminando matriz " << registro.obtener(h)->getNombre() << "...\n";
+                    registro.eliminar(h);
                     cout << "Matriz eliminada.\n";
                 }
                 break;
@@ -424,21 +4709,122 @@ int main() {
 
             case 10: {
                 cout << " EJEMPLOS PREDEFINIDOS \n";
-                Matriz* m1 = new Matriz(3, 3, 1.0, 5.0, "Ejemplo1");
+                Matriz* m1 = registro.obtener(registro.agregar(Matriz(3, 3, 1.0, 5.0, "Ejemplo1")));
                 m1->imprimir();
-                matrices.push_back(m1);
 
                 Matriz transp = m1->transpuesta();
                 transp.imprimir();
 
-                Matriz* m2 = new Matriz(3, 2, 0.0, 3.0, "Ejemplo2");
+                Matriz* m2 = registro.obtener(registro.agregar(Matriz(3, 2, 0.0, 3.0, "Ejemplo2")));
                 m2->imprimir();
-                matrices.push_back(m2);
 
                 cout << "Ejemplos añadidos al almacén.\n";
                 break;
             }
 
+            case 11: {
+                menuRendimiento();
+                break;
+            }
+
+            case 12: {
+                cout << " GUARDAR MATRIZ \n";
+                Matriz* m = seleccionarMatriz(registro, "Seleccione la matriz a guardar: ");
+                if (!m) break;
+                string ruta;
+                cout << "Ruta del archivo: ";
+                cin >> ruta;
+                if (guardarBinario(*m, ruta))
+                    cout << "Matriz " << m->getNombre() << " guardada en " << ruta << ".\n";
+                break;
+            }
+
+            case 13: {
+                cout << " CARGAR MATRIZ \n";
+                string ruta;
+                cout << "Ruta del archivo: ";
+                cin >> ruta;
+                MatrizMapeada archivo(ruta);
+                if (archivo.esValida()) {
+                    Matriz* nueva = registro.obtener(registro.agregar(Matriz(archivo.vista())));
+                    cout << "\nMatriz cargada exitosamente:\n";
+                    nueva->imprimir();
+                }
+                break;
+            }
+
+            case 14: {
+                cout << " DETERMINANTE E INVERSA \n";
+                Matriz* m = seleccionarMatriz(registro, "Seleccione la matriz: ");
+                if (!m) break;
+                if (m->getFilas() != m->getColumnas()) {
+                    cout << "Error: La matriz debe ser cuadrada.\n";
+                    break;
+                }
+                DescomposicionLU lu(*m);
+                cout << "Determinante: " << lu.determinante() << "\n";
+                if (lu.esSingular()) {
+                    cout << "La matriz es singular: no tiene inversa.\n";
+                    break;
+                }
+                Matriz inversa = lu.inversa();
+                inversa.imprimir();
+
+                char guardar;
+                cout << "¿Desea guardar la inversa? (s/n): ";
+                cin >> guardar;
+                if (guardar == 's' || guardar == 'S') {
+                    registro.agregar(move(inversa));
+                    cout << "Inversa guardada.\n";
+                }
+                break;
+            }
+
+            case 15: {
+                cout << " RESOLVER A X = B \n";
+                if (registro.tamano() < 2) {
+                    cout << "Debe haber al menos dos matrices.\n";
+                    break;
+                }
+                Matriz* a = seleccionarMatriz(registro, "Matriz A (cuadrada): ");
+                if (!a) break;
+                Matriz* b = seleccionarMatriz(registro, "Matriz B (lados derechos por columnas): ");
+                if (!b) break;
+                if (a->getFilas() != a->getColumnas() || b->getFilas() != a->getFilas()) {
+                    cout << "Error: A debe ser cuadrada y B tener tantas filas como A.\n";
+                    break;
+                }
+                char mixta;
+                cout << "¿Factorizar en float y refinar en double? (s/n): ";
+                cin >> mixta;
+                Matriz x(1, 1, true, "X");
+                if (mixta == 's' || mixta == 'S') {
+                    EstadisticasRefinamiento estadisticas;
+                    x = resolverRefinado(*a, *b, &estadisticas);
+                    cout << "Pasos de refinamiento: " << estadisticas.pasos << ", residuo relativo: "
+                         << scientific << estadisticas.residuo << fixed
+                         << (estadisticas.convergio ? "\n" : " (resuelto en double)\n");
+                } else {
+                    x = a->resolver(*b);
+                }
+                x.imprimir();
+
+                char guardar;
+                cout << "¿Desea guardar la solución? (s/n): ";
+                cin >> guardar;
+                if (guardar == 's' || guardar == 'S') {
+                    registro.agregar(move(x));
+                    cout << "Solución guardada.\n";
+                }
+                break;
+            }
+
+            case 16: {
+                cout << " ESTADISTICAS DE MEMORIA \n";
+                PoolMatrices::global().imprimirEstadisticas();
+                break;
+            }
+
             case 0:
                 cout << "Liberando memoria y saliendo...\n";
                 break;
@@ -455,9 +4841,7 @@ int main() {
 
     } while (opcion != 0);
 
-    for (auto* m : matrices)
-        delete m;
-    matrices.clear();
+    registro.vaciar();
 
     return 0;
 }